@@ -2,6 +2,8 @@
 
 namespace coda::db {
 
+  std::string_view column_impl::to_view() const { throw value_conversion_error("column values can not be viewed"); }
+
   column::column(const std::shared_ptr<column_impl> &impl) : impl_(impl) {
     if (impl_ == nullptr) {
       throw database_exception("no implementation for column");
@@ -40,6 +42,13 @@ namespace coda::db {
     return impl_->name();
   }
 
+  std::string_view column::as_view() const {
+    if (impl_ == nullptr) {
+      return std::string_view();
+    }
+    return impl_->to_view();
+  }
+
   std::shared_ptr<column_impl> column::impl() const { return impl_; }
 
   column::operator sql_number() const { return impl_->to_value(); }
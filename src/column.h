@@ -9,6 +9,7 @@
 #include <cassert>
 #include <memory>
 #include <string>
+#include <string_view>
 #include "sql_types.h"
 #include "sql_value.h"
 
@@ -48,6 +49,14 @@ namespace coda::db {
      * @return the name of this column;
      */
     virtual std::string name() const = 0;
+
+    /*!
+     * gets the bytes of a text or blob value from the driver's buffer without copying.
+     * @return a view that is only valid until the results move to another row,
+     *         empty if the value is null
+     * @throws value_conversion_error if the value has no view
+     */
+    virtual std::string_view to_view() const;
   };
 
   /*!
@@ -101,6 +110,12 @@ namespace coda::db {
      */
     std::string name() const;
 
+    /*!
+     * gets the bytes of a text or blob value without copying
+     * @return a view that is only valid until the results move to another row
+     */
+    std::string_view as_view() const;
+
     /*!
      * @return the instance of the implementation
      */
@@ -0,0 +1,221 @@
+/*!
+ * @copyright ryan jennings (coda.life), 2013
+ */
+#include "column_batch.h"
+#include "exception.h"
+#include "number_format.h"
+
+using namespace std;
+
+namespace coda::db {
+
+  batch_column::batch_column(type type) : type_(type), size_(0) {
+    if (type_ == text || type_ == blob) {
+      offsets_.push_back(0);
+    }
+  }
+
+  batch_column::type batch_column::kind() const noexcept { return type_; }
+
+  size_t batch_column::size() const noexcept { return size_; }
+
+  bool batch_column::is_null(size_t row) const {
+    if (row >= size_) {
+      throw database_exception("row " + std::to_string(row) + " is not in the batch");
+    }
+    return (nulls_[row / 64] >> (row % 64)) & 1;
+  }
+
+  const vector<uint64_t> &batch_column::nulls() const noexcept { return nulls_; }
+
+  const vector<long long> &batch_column::integers() const noexcept { return integers_; }
+
+  const vector<double> &batch_column::reals() const noexcept { return reals_; }
+
+  const vector<size_t> &batch_column::offsets() const noexcept { return offsets_; }
+
+  const string &batch_column::arena() const noexcept { return arena_; }
+
+  string_view batch_column::data(size_t row) const {
+    if (row >= size_ || (type_ != text && type_ != blob)) {
+      return string_view();
+    }
+    return string_view(arena_.data() + offsets_[row], offsets_[row + 1] - offsets_[row]);
+  }
+
+  void batch_column::append_row(bool null) {
+    if (size_ % 64 == 0) {
+      nulls_.push_back(0);
+    }
+
+    if (null) {
+      nulls_.back() |= uint64_t(1) << (size_ % 64);
+    }
+
+    size_++;
+  }
+
+  void batch_column::append_null() {
+    switch (type_) {
+      case integer:
+        integers_.push_back(0);
+        break;
+      case real:
+        reals_.push_back(0);
+        break;
+      case text:
+      case blob:
+        offsets_.push_back(arena_.size());
+        break;
+    }
+    append_row(true);
+  }
+
+  void batch_column::append(long long value) {
+    switch (type_) {
+      case integer:
+        integers_.push_back(value);
+        break;
+      case real:
+        reals_.push_back(static_cast<double>(value));
+        break;
+      case text:
+      case blob: {
+        char buf[helper::NUMBER_BUFFER_SIZE];
+        auto end = helper::format_number(buf, buf + sizeof(buf), value);
+        arena_.append(buf, end == nullptr ? 0 : static_cast<size_t>(end - buf));
+        offsets_.push_back(arena_.size());
+        break;
+      }
+    }
+    append_row(false);
+  }
+
+  void batch_column::append(double value) {
+    switch (type_) {
+      case integer:
+        integers_.push_back(static_cast<long long>(value));
+        break;
+      case real:
+        reals_.push_back(value);
+        break;
+      case text:
+      case blob: {
+        char buf[helper::NUMBER_BUFFER_SIZE];
+        auto end = helper::format_number(buf, buf + sizeof(buf), value);
+        arena_.append(buf, end == nullptr ? 0 : static_cast<size_t>(end - buf));
+        offsets_.push_back(arena_.size());
+        break;
+      }
+    }
+    append_row(false);
+  }
+
+  void batch_column::append(const char *data, size_t size) {
+    switch (type_) {
+      case integer: {
+        long long number = 0;
+        double fraction = 0;
+        if (data != nullptr && !helper::parse_number(string_view(data, size), number) &&
+            helper::parse_number(string_view(data, size), fraction)) {
+          number = static_cast<long long>(fraction);
+        }
+        integers_.push_back(number);
+        break;
+      }
+      case real: {
+        double number = 0;
+        if (data != nullptr) {
+          helper::parse_number(string_view(data, size), number);
+        }
+        reals_.push_back(number);
+        break;
+      }
+      case text:
+      case blob:
+        if (data != nullptr) {
+          arena_.append(data, size);
+        }
+        offsets_.push_back(arena_.size());
+        break;
+    }
+    append_row(false);
+  }
+
+  void batch_column::clear() noexcept {
+    size_ = 0;
+    integers_.clear();
+    reals_.clear();
+    arena_.clear();
+    nulls_.clear();
+    offsets_.clear();
+
+    if (type_ == text || type_ == blob) {
+      offsets_.push_back(0);
+    }
+  }
+
+  void column_batch::reset(const shared_ptr<column_index> &names, const vector<batch_column::type> &types) {
+    bool reusable = columns_.size() == types.size();
+
+    for (size_t i = 0; reusable && i < types.size(); i++) {
+      reusable = columns_[i].kind() == types[i];
+    }
+
+    names_ = names;
+
+    if (reusable) {
+      for (auto &column : columns_) {
+        column.clear();
+      }
+      return;
+    }
+
+    columns_.clear();
+    columns_.reserve(types.size());
+
+    for (auto type : types) {
+      columns_.emplace_back(type);
+    }
+  }
+
+  size_t column_batch::size() const noexcept { return columns_.empty() ? 0 : columns_[0].size(); }
+
+  bool column_batch::empty() const noexcept { return size() == 0; }
+
+  size_t column_batch::column_count() const noexcept { return columns_.size(); }
+
+  string column_batch::column_name(size_t index) const {
+    if (index >= columns_.size() || names_ == nullptr) {
+      throw no_such_column_exception();
+    }
+    return names_->name(index);
+  }
+
+  batch_column &column_batch::column(size_t index) {
+    if (index >= columns_.size()) {
+      throw no_such_column_exception();
+    }
+    return columns_[index];
+  }
+
+  const batch_column &column_batch::column(size_t index) const {
+    if (index >= columns_.size()) {
+      throw no_such_column_exception();
+    }
+    return columns_[index];
+  }
+
+  const batch_column &column_batch::column(const string &name) const {
+    auto index = names_ == nullptr ? column_index::npos : names_->find(name);
+
+    if (index == column_index::npos || index >= columns_.size()) {
+      throw no_such_column_exception(name);
+    }
+    return columns_[index];
+  }
+
+  const batch_column &column_batch::operator[](size_t index) const { return column(index); }
+
+  const batch_column &column_batch::operator[](const string &name) const { return column(name); }
+}  // namespace coda::db
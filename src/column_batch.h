@@ -0,0 +1,163 @@
+/*!
+ * @file column_batch.h
+ * a batch of result rows stored by column
+ */
+#ifndef CODA_DB_COLUMN_BATCH_H
+#define CODA_DB_COLUMN_BATCH_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "column_index.h"
+
+namespace coda::db {
+
+  /*!
+   * the values of one column in a batch, stored contiguously by type.
+   * text and blobs are stored in a single arena with an offset for each row.
+   */
+  class batch_column {
+   public:
+    /*!
+     * the storage type of a column
+     */
+    enum type { integer, real, text, blob };
+
+   private:
+    type type_;
+    size_t size_;
+    std::vector<long long> integers_;
+    std::vector<double> reals_;
+    std::vector<size_t> offsets_;
+    std::string arena_;
+    std::vector<uint64_t> nulls_;
+    void append_row(bool null);
+
+   public:
+    /*!
+     * @param type the storage type of the column
+     */
+    explicit batch_column(type type);
+
+    /*!
+     * @return the storage type of the column
+     */
+    type kind() const noexcept;
+
+    /*!
+     * @return the number of rows
+     */
+    size_t size() const noexcept;
+
+    /*!
+     * @param row the index of the row
+     * @return true if the value is null
+     */
+    bool is_null(size_t row) const;
+
+    /*!
+     * @return the null bitmap, one bit per row starting at the low bit of the first word
+     */
+    const std::vector<uint64_t> &nulls() const noexcept;
+
+    /*!
+     * @return the values of an integer column, zero where null
+     */
+    const std::vector<long long> &integers() const noexcept;
+
+    /*!
+     * @return the values of a real column, zero where null
+     */
+    const std::vector<double> &reals() const noexcept;
+
+    /*!
+     * @return the offsets into the arena for a text or blob column, with one more than the number of rows
+     */
+    const std::vector<size_t> &offsets() const noexcept;
+
+    /*!
+     * @return the data of a text or blob column
+     */
+    const std::string &arena() const noexcept;
+
+    /*!
+     * @param row the index of the row
+     * @return the text or blob data of a row, valid while the batch is unchanged
+     */
+    std::string_view data(size_t row) const;
+
+    /* appends a row */
+    void append_null();
+    void append(long long value);
+    void append(double value);
+    void append(const char *data, size_t size);
+
+    /*!
+     * removes the rows, keeping the storage for reuse
+     */
+    void clear() noexcept;
+  };
+
+  /*!
+   * a batch of result rows stored as one array per column
+   */
+  class column_batch {
+   private:
+    std::vector<batch_column> columns_;
+    std::shared_ptr<column_index> names_;
+
+   public:
+    column_batch() = default;
+
+    /*!
+     * removes the rows and sets the columns. storage is kept if the columns are unchanged.
+     * @param names the names of the columns
+     * @param types the storage type of each column
+     */
+    void reset(const std::shared_ptr<column_index> &names, const std::vector<batch_column::type> &types);
+
+    /*!
+     * @return the number of rows
+     */
+    size_t size() const noexcept;
+
+    /*!
+     * @return true if there are no rows
+     */
+    bool empty() const noexcept;
+
+    /*!
+     * @return the number of columns
+     */
+    size_t column_count() const noexcept;
+
+    /*!
+     * @param index the index of the column
+     * @return the name of the column
+     */
+    std::string column_name(size_t index) const;
+
+    /*!
+     * @param index the index of the column
+     * @return the column
+     * @throws no_such_column_exception if the index is out of range
+     */
+    batch_column &column(size_t index);
+    const batch_column &column(size_t index) const;
+
+    /*!
+     * @param name the name of the column
+     * @return the column
+     * @throws no_such_column_exception if the column was not found
+     */
+    const batch_column &column(const std::string &name) const;
+
+    const batch_column &operator[](size_t index) const;
+
+    const batch_column &operator[](const std::string &name) const;
+  };
+}  // namespace coda::db
+
+#endif
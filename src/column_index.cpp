@@ -0,0 +1,63 @@
+/*!
+ * @copyright ryan jennings (coda.life), 2013
+ */
+#include "column_index.h"
+#include <algorithm>
+#include <cctype>
+#include "exception.h"
+
+using namespace std;
+
+namespace coda::db {
+
+  namespace helper {
+    string fold_case(const string &value) {
+      string folded(value);
+      std::transform(folded.begin(), folded.end(), folded.begin(),
+                     [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+      return folded;
+    }
+  }  // namespace helper
+
+  column_index::column_index(const vector<string> &names, bool ignoreCase) : names_(names), ignoreCase_(ignoreCase) {
+    ordinals_.reserve(names_.size());
+
+    for (size_t i = 0; i < names_.size(); i++) {
+      // emplace keeps the first of any duplicate names
+      ordinals_.emplace(names_[i], i);
+
+      if (ignoreCase_) {
+        folded_.emplace(helper::fold_case(names_[i]), i);
+      }
+    }
+  }
+
+  size_t column_index::find(const string &name) const {
+    auto it = ordinals_.find(name);
+
+    if (it != ordinals_.end()) {
+      return it->second;
+    }
+
+    if (ignoreCase_) {
+      it = folded_.find(helper::fold_case(name));
+
+      if (it != folded_.end()) {
+        return it->second;
+      }
+    }
+
+    return npos;
+  }
+
+  const string &column_index::name(size_t ordinal) const {
+    if (ordinal >= names_.size()) {
+      throw no_such_column_exception();
+    }
+    return names_[ordinal];
+  }
+
+  size_t column_index::size() const noexcept { return names_.size(); }
+
+  bool column_index::ignore_case() const noexcept { return ignoreCase_; }
+}  // namespace coda::db
@@ -0,0 +1,62 @@
+/*!
+ * @file column_index.h
+ * a lookup of column ordinals by name
+ */
+#ifndef CODA_DB_COLUMN_INDEX_H
+#define CODA_DB_COLUMN_INDEX_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace coda::db {
+
+  /*!
+   * maps the column names of a result to their ordinals.
+   * built once per result and shared by the rows it produces.
+   */
+  class column_index {
+   private:
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, size_t> ordinals_;
+    std::unordered_map<std::string, size_t> folded_;
+    bool ignoreCase_;
+
+   public:
+    /*!
+     * the ordinal returned when a name is not found
+     */
+    static const size_t npos = static_cast<size_t>(-1);
+
+    /*!
+     * @param names      the column names in order
+     * @param ignoreCase true to also match names case insensitively
+     */
+    explicit column_index(const std::vector<std::string> &names, bool ignoreCase = false);
+
+    /*!
+     * finds a column ordinal.  when there are duplicate names the first is found.
+     * @param name the name of the column
+     * @return the ordinal of the column or npos if not found
+     */
+    size_t find(const std::string &name) const;
+
+    /*!
+     * @param ordinal the ordinal of the column
+     * @return the name of the column
+     */
+    const std::string &name(size_t ordinal) const;
+
+    /*!
+     * @return the number of columns
+     */
+    size_t size() const noexcept;
+
+    /*!
+     * @return true if names are matched case insensitively
+     */
+    bool ignore_case() const noexcept;
+  };
+}  // namespace coda::db
+
+#endif
@@ -1,4 +1,7 @@
 #include "insert_query.h"
+#include <algorithm>
+#include <iterator>
+#include "resultset.h"
 #include "schema.h"
 #include "statement.h"
 
@@ -40,13 +43,21 @@ namespace coda::db {
       : modify_query(std::move(other)),
         lastId_(other.lastId_),
         columns_(std::move(other.columns_)),
-        tableName_(std::move(other.tableName_)) {}
+        tableName_(std::move(other.tableName_)),
+        rows_(std::move(other.rows_)),
+        lastIds_(std::move(other.lastIds_)),
+        batchSize_(other.batchSize_),
+        conflictKeys_(std::move(other.conflictKeys_)) {}
 
   insert_query &insert_query::operator=(const insert_query &other) {
     modify_query::operator=(other);
     lastId_ = other.lastId_;
     columns_ = other.columns_;
     tableName_ = other.tableName_;
+    rows_ = other.rows_;
+    lastIds_ = other.lastIds_;
+    batchSize_ = other.batchSize_;
+    conflictKeys_ = other.conflictKeys_;
     return *this;
   }
 
@@ -55,6 +66,10 @@ namespace coda::db {
     lastId_ = other.lastId_;
     columns_ = std::move(other.columns_);
     tableName_ = std::move(other.tableName_);
+    rows_ = std::move(other.rows_);
+    lastIds_ = std::move(other.lastIds_);
+    batchSize_ = other.batchSize_;
+    conflictKeys_ = std::move(other.conflictKeys_);
     return *this;
   }
 
@@ -71,11 +86,31 @@ namespace coda::db {
 
     buf += coda::db::helper::join_csv(columns_);
 
-    buf += ") VALUES(";
+    buf += ") VALUES";
 
-    buf += session_->join_params(columns_);
+    auto impl = session_->impl();
 
-    buf += ")";
+    size_t index = 1;
+
+    // a multi-row insert numbers its parameters across all rows
+    for (size_t row = 0; row < std::max<size_t>(1, batchSize_); row++) {
+      if (row > 0) {
+        buf += ",";
+      }
+
+      buf += "(";
+
+      for (size_t col = 0; col < columns_.size(); col++) {
+        if (col > 0) {
+          buf += ",";
+        }
+        buf += impl->bind_param(index++);
+      }
+
+      buf += ")";
+    }
+
+    buf += generate_conflict_sql();
 
     if (session_->has_feature(session::FEATURE_RETURNING)) {
       auto schema = session_->get_schema(tableName_);
@@ -89,7 +124,7 @@ namespace coda::db {
           buf += " RETURNING ";
 
           while (it < keys.end() - 1) {
-            buf += *it;
+            buf += *it++;
             buf += ",";
           }
 
@@ -102,6 +137,93 @@ namespace coda::db {
     return buf;
   }
 
+  string insert_query::generate_conflict_sql() const {
+    string buf;
+
+    if (conflictKeys_.empty()) {
+      return buf;
+    }
+
+    vector<string> updates;
+
+    std::copy_if(columns_.begin(), columns_.end(), std::back_inserter(updates), [&](const string &column) {
+      return std::find(conflictKeys_.begin(), conflictKeys_.end(), column) == conflictKeys_.end();
+    });
+
+    if (session_->has_feature(session::FEATURE_ON_DUPLICATE_KEY)) {
+      buf += " ON DUPLICATE KEY UPDATE ";
+
+      // a key assigned to itself is the only way to do nothing
+      if (updates.empty()) {
+        buf += conflictKeys_.front();
+        buf += "=";
+        buf += conflictKeys_.front();
+        return buf;
+      }
+
+      for (auto it = updates.begin(); it != updates.end(); ++it) {
+        if (it != updates.begin()) {
+          buf += ",";
+        }
+        buf += *it;
+        buf += "=VALUES(";
+        buf += *it;
+        buf += ")";
+      }
+      return buf;
+    }
+
+    buf += " ON CONFLICT(";
+    buf += coda::db::helper::join_csv(conflictKeys_);
+    buf += ") DO ";
+
+    if (updates.empty()) {
+      buf += "NOTHING";
+      return buf;
+    }
+
+    buf += "UPDATE SET ";
+
+    for (auto it = updates.begin(); it != updates.end(); ++it) {
+      if (it != updates.begin()) {
+        buf += ",";
+      }
+      buf += *it;
+      buf += "=EXCLUDED.";
+      buf += *it;
+    }
+    return buf;
+  }
+
+  insert_query &insert_query::on_conflict() {
+    auto schema = session_->get_schema(tableName_);
+
+    if (schema == nullptr) {
+      throw database_exception("no schema for upsert into " + tableName_);
+    }
+
+    if (!schema->is_valid()) {
+      schema->init();
+    }
+
+    return on_conflict(schema->primary_keys());
+  }
+
+  insert_query &insert_query::on_conflict(const std::vector<std::string> &keys) {
+    if (!session_->has_feature(session::FEATURE_ON_CONFLICT) &&
+        !session_->has_feature(session::FEATURE_ON_DUPLICATE_KEY)) {
+      throw database_exception("upsert is not supported by this database");
+    }
+
+    if (keys.empty()) {
+      throw database_exception("no keys for upsert into " + tableName_);
+    }
+
+    conflictKeys_ = keys;
+    set_modified();
+    return *this;
+  }
+
   insert_query &insert_query::columns(const vector<string> &columns) {
     columns_ = columns;
     set_modified();
@@ -115,6 +237,10 @@ namespace coda::db {
       throw database_exception("invalid insert query");
     }
 
+    if (!rows_.empty()) {
+      return execute_batch();
+    }
+
     prepare(to_sql());
 
     if (stmt_->execute()) {
@@ -130,6 +256,102 @@ namespace coda::db {
     return numChanges_;
   }
 
+  sql_changes insert_query::execute_batch() {
+    if (columns_.empty()) {
+      throw database_exception("no columns for multi-row insert");
+    }
+
+    for (const auto &row : rows_) {
+      if (row.size() != columns_.size()) {
+        throw binding_error("multi-row insert row does not match the number of columns");
+      }
+    }
+
+    auto rows = std::move(rows_);
+    rows_.clear();
+
+    auto perStatement = std::max<size_t>(1, session_->max_bind_params() / columns_.size());
+
+    auto returning = false;
+
+    if (session_->has_feature(session::FEATURE_RETURNING)) {
+      auto schema = session_->get_schema(tableName_);
+
+      // the generated sql only returns keys when there are some
+      returning = schema != nullptr && !schema->primary_keys().empty();
+    }
+
+    numChanges_ = 0;
+    lastId_ = 0;
+    lastIds_.clear();
+
+    try {
+      for (size_t offset = 0; offset < rows.size(); offset += perStatement) {
+        auto count = std::min(perStatement, rows.size() - offset);
+
+        // only the last chunk can change the sql
+        if (count != batchSize_) {
+          batchSize_ = count;
+          set_modified();
+        }
+
+        size_t index = 1;
+
+        for (size_t row = offset; row < offset + count; row++) {
+          for (const auto &value : rows[row]) {
+            bind(index++, value);
+          }
+        }
+
+        prepare(to_sql());
+
+        if (returning) {
+          auto results = stmt_->query();
+
+          for (auto row : results) {
+            lastIds_.push_back(row.column(0).as<sql_id>());
+          }
+
+          numChanges_ += stmt_->last_number_of_changes();
+        } else if (stmt_->execute()) {
+          numChanges_ += stmt_->last_number_of_changes();
+          lastId_ = stmt_->last_insert_id();
+        } else {
+          throw database_exception("unable to execute multi-row insert: " + stmt_->last_error());
+        }
+
+        reset();
+      }
+    } catch (...) {
+      batchSize_ = 0;
+      set_modified();
+      throw;
+    }
+
+    if (!lastIds_.empty()) {
+      lastId_ = lastIds_.back();
+    }
+
+    batchSize_ = 0;
+    set_modified();
+
+    return numChanges_;
+  }
+
+  insert_query &insert_query::add_row(const std::vector<sql_value> &row) {
+    rows_.push_back(row);
+    return *this;
+  }
+
+  insert_query &insert_query::values_batch(const std::vector<std::vector<sql_value>> &rows) {
+    rows_.insert(rows_.end(), rows.begin(), rows.end());
+    return *this;
+  }
+
+  size_t insert_query::num_of_rows() const noexcept { return rows_.size(); }
+
+  std::vector<sql_id> insert_query::last_insert_ids() const { return lastIds_; }
+
   insert_query &insert_query::into(const std::string &value) {
     tableName_ = value;
     set_modified();
@@ -140,25 +362,21 @@ namespace coda::db {
 
   insert_query &insert_query::values(const std::vector<sql_value> &value) {
     bindable::bind(value);
-    set_modified();
     return *this;
   }
 
   insert_query &insert_query::values(const std::unordered_map<std::string, sql_value> &value) {
     bindable::bind(value);
-    set_modified();
     return *this;
   }
 
   insert_query &insert_query::value(const std::string &name, const sql_value &value) {
     bind(name, value);
-    set_modified();
     return *this;
   }
 
   insert_query &insert_query::value(const sql_value &value) {
     bind(num_of_bindings() + 1, value);
-    set_modified();
     return *this;
   }
 }  // namespace coda::db
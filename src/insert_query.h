@@ -103,7 +103,59 @@ namespace coda::db {
     insert_query &value(const sql_value &value);
 
     /*!
-     * executes the insert query
+     * adds a row of values for a multi-row insert
+     * @param value the value for the first column
+     * @param argv a variadic list of values for the remaining columns
+     * @return a reference to this instance
+     */
+    template<typename T, typename... List>
+    insert_query &add_row(const T &value, const List &... argv) {
+      return add_row(std::vector<sql_value>{sql_value(value), sql_value(argv)...});
+    }
+
+    /*!
+     * adds a row of values for a multi-row insert
+     * @param row the values, one for each column
+     * @return a reference to this instance
+     */
+    insert_query &add_row(const std::vector<sql_value> &row);
+
+    /*!
+     * adds rows of values for a multi-row insert
+     * @param rows the rows of values, one value for each column
+     * @return a reference to this instance
+     */
+    insert_query &values_batch(const std::vector<std::vector<sql_value>> &rows);
+
+    /*!
+     * updates the existing row instead when an insert conflicts with the primary keys of the table
+     * @return a reference to this instance
+     */
+    insert_query &on_conflict();
+
+    /*!
+     * updates the existing row instead when an insert conflicts with a set of unique columns.
+     * the inserted columns that are not keys are updated.
+     * @param keys the unique columns that can conflict
+     * @return a reference to this instance
+     */
+    insert_query &on_conflict(const std::vector<std::string> &keys);
+
+    /*!
+     * @return the number of rows waiting for a multi-row insert
+     */
+    size_t num_of_rows() const noexcept;
+
+    /*!
+     * gets the id of each row from the last multi-row insert.
+     * only available when the session supports returning values.
+     * @return the list of ids
+     */
+    std::vector<sql_id> last_insert_ids() const;
+
+    /*!
+     * executes the insert query.  if rows were added, they are inserted
+     * with as few multi-row statements as the parameter limit allows.
      * @return the number of records inserted
      */
     sql_changes execute() override;
@@ -125,9 +177,17 @@ namespace coda::db {
 
     std::string generate_sql() const override;
 
-    sql_id lastId_;
+    sql_changes execute_batch();
+
+    std::string generate_conflict_sql() const;
+
+    sql_id lastId_ = 0;
     std::vector<std::string> columns_;
     std::string tableName_;
+    std::vector<std::vector<sql_value>> rows_;
+    std::vector<sql_id> lastIds_;
+    size_t batchSize_ = 0;
+    std::vector<std::string> conflictKeys_;
   };
 }  // namespace coda::db
 
@@ -1,15 +1,16 @@
 
 #include <cassert>
-#include <codecvt>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
-#include <locale>
 #include <memory>
 #include <regex>
 
 #include "../alloc.h"
 #include "../exception.h"
+#include "../number_format.h"
 #include "../sql_value.h"
+#include "../unicode.h"
 #include "binding.h"
 
 namespace coda::db::mysql {
@@ -23,6 +24,12 @@ namespace coda::db::mysql {
       return ptr;
     }
 
+    // variable length results start small and grow when a value is truncated
+    const unsigned long INITIAL_RESULT_SIZE = 256;
+
+    // grown result buffers larger than this are shrunk before they are reused
+    const unsigned long MAX_RETAINED_RESULT_SIZE = 64 * 1024;
+
     /**
      * function to assign a mysql field to a mysql binding value
      * @param value the binding value
@@ -65,8 +72,14 @@ namespace coda::db::mysql {
         case MYSQL_TYPE_TINY_BLOB:
         case MYSQL_TYPE_MEDIUM_BLOB:
         case MYSQL_TYPE_LONG_BLOB:
+        case MYSQL_TYPE_DECIMAL:
+        case MYSQL_TYPE_NEWDECIMAL:
+        case MYSQL_TYPE_ENUM:
+        case MYSQL_TYPE_SET:
+        case MYSQL_TYPE_GEOMETRY:
           value->length = c_alloc<unsigned long>();
-          value->buffer_length = field->length;
+          // leave room for a terminator so strings can be read from the buffer
+          value->buffer_length = std::min<unsigned long>(field->length + 1, INITIAL_RESULT_SIZE);
           break;
         case MYSQL_TYPE_DATETIME:
         case MYSQL_TYPE_DATE:
@@ -126,7 +139,6 @@ namespace coda::db::mysql {
      * @return         the parsed sql_time value or sql_null
      */
     sql_value parse_time(MYSQL_BIND *binding, sql_time::formats format) {
-      struct tm sys {};
       MYSQL_TIME *db_tm;
 
       // sanity check
@@ -140,16 +152,13 @@ namespace coda::db::mysql {
         return sql_null;
       }
 
-      memset(&sys, 0, sizeof(sys));
+      auto value = sql_time::from_parts(static_cast<int>(db_tm->year), db_tm->month, db_tm->day, db_tm->hour,
+                                        db_tm->minute, db_tm->second, db_tm->second_part, format);
 
-      sys.tm_year = db_tm->year - 1900;
-      sys.tm_mon = db_tm->month - 1;
-      sys.tm_mday = db_tm->day;
-      sys.tm_hour = db_tm->hour;
-      sys.tm_min = db_tm->minute;
-      sys.tm_sec = db_tm->second;
-
-      return sql_time(timegm(&sys), format);
+      if (db_tm->neg) {
+        return sql_time(sql_time::time_point() - value.to_time_point().time_since_epoch(), format);
+      }
+      return value;
     }
 
     extern std::string last_stmt_error(MYSQL_STMT *stmt);
@@ -177,6 +186,129 @@ namespace coda::db::mysql {
         return sql_number(*p);
       }
     }
+    /**
+     * reads an integer from a binding without creating a value
+     */
+    template <typename T>
+    long long read_integer(MYSQL_BIND *binding) {
+      if (binding->is_unsigned) {
+        return static_cast<long long>(*static_cast<typename std::make_unsigned<T>::type *>(binding->buffer));
+      }
+      return static_cast<long long>(*static_cast<T *>(binding->buffer));
+    }
+
+    long long to_int64(MYSQL_BIND *binding) {
+      if (binding == nullptr || binding->buffer == nullptr || (binding->is_null && *binding->is_null)) {
+        return 0;
+      }
+
+      switch (binding->buffer_type) {
+        case MYSQL_TYPE_TINY:
+        case MYSQL_TYPE_SHORT:
+        case MYSQL_TYPE_INT24:
+        case MYSQL_TYPE_LONG:
+          switch (binding->buffer_length) {
+            case sizeof(char):
+              return read_integer<char>(binding);
+            case sizeof(short):
+              return read_integer<short>(binding);
+            case sizeof(int):
+            default:
+              return read_integer<int>(binding);
+            case sizeof(long):
+              return read_integer<long>(binding);
+          }
+        case MYSQL_TYPE_LONGLONG:
+          return read_integer<long long>(binding);
+        case MYSQL_TYPE_FLOAT:
+        case MYSQL_TYPE_DOUBLE:
+          return static_cast<long long>(to_double(binding));
+        default: {
+          auto value = to_value(binding);
+          return value == sql_null ? 0 : value.as<long long>();
+        }
+      }
+    }
+
+    double to_double(MYSQL_BIND *binding) {
+      if (binding == nullptr || binding->buffer == nullptr || (binding->is_null && *binding->is_null)) {
+        return 0;
+      }
+
+      switch (binding->buffer_type) {
+        case MYSQL_TYPE_FLOAT:
+          return *static_cast<float *>(binding->buffer);
+        case MYSQL_TYPE_DOUBLE:
+          return *static_cast<double *>(binding->buffer);
+        case MYSQL_TYPE_TINY:
+        case MYSQL_TYPE_SHORT:
+        case MYSQL_TYPE_INT24:
+        case MYSQL_TYPE_LONG:
+        case MYSQL_TYPE_LONGLONG:
+          return static_cast<double>(to_int64(binding));
+        default: {
+          auto value = to_value(binding);
+          return value == sql_null ? 0 : value.as<double>();
+        }
+      }
+    }
+
+    std::string to_text(MYSQL_BIND *binding) {
+      if (binding == nullptr || binding->buffer == nullptr || (binding->is_null && *binding->is_null)) {
+        return std::string();
+      }
+
+      switch (binding->buffer_type) {
+        case MYSQL_TYPE_VAR_STRING:
+        case MYSQL_TYPE_VARCHAR:
+        case MYSQL_TYPE_DECIMAL:
+        case MYSQL_TYPE_NEWDECIMAL:
+        case MYSQL_TYPE_ENUM:
+        case MYSQL_TYPE_SET:
+        case MYSQL_TYPE_STRING:
+        case MYSQL_TYPE_TINY_BLOB:
+        case MYSQL_TYPE_MEDIUM_BLOB:
+        case MYSQL_TYPE_LONG_BLOB:
+        case MYSQL_TYPE_BLOB:
+          if (binding->length) {
+            return std::string(static_cast<const char *>(binding->buffer),
+                               std::min(*binding->length, binding->buffer_length));
+          }
+          return std::string(static_cast<const char *>(binding->buffer));
+        default: {
+          auto value = to_value(binding);
+          return value == sql_null ? std::string() : value.as<std::string>();
+        }
+      }
+    }
+
+    std::string_view to_view(MYSQL_BIND *binding) {
+      if (binding == nullptr || binding->buffer == nullptr || (binding->is_null && *binding->is_null)) {
+        return std::string_view();
+      }
+
+      switch (binding->buffer_type) {
+        case MYSQL_TYPE_VAR_STRING:
+        case MYSQL_TYPE_VARCHAR:
+        case MYSQL_TYPE_DECIMAL:
+        case MYSQL_TYPE_NEWDECIMAL:
+        case MYSQL_TYPE_ENUM:
+        case MYSQL_TYPE_SET:
+        case MYSQL_TYPE_STRING:
+        case MYSQL_TYPE_TINY_BLOB:
+        case MYSQL_TYPE_MEDIUM_BLOB:
+        case MYSQL_TYPE_LONG_BLOB:
+        case MYSQL_TYPE_BLOB:
+          if (binding->length) {
+            return std::string_view(static_cast<const char *>(binding->buffer),
+                                    std::min(*binding->length, binding->buffer_length));
+          }
+          return std::string_view(static_cast<const char *>(binding->buffer));
+        default:
+          throw value_conversion_error("only text and blob values can be viewed");
+      }
+    }
+
     /**
      * Key method here, handles conversion from MYSQL_BIND to sql_value
      * TODO: test this more
@@ -226,7 +358,13 @@ namespace coda::db::mysql {
         case MYSQL_TYPE_GEOMETRY:
         case MYSQL_TYPE_NEWDECIMAL:
         case MYSQL_TYPE_STRING:
-        default: { return sql_string(static_cast<const char *>(binding->buffer)); }
+        default: {
+          if (binding->length) {
+            return sql_string(static_cast<const char *>(binding->buffer),
+                              std::min(*binding->length, binding->buffer_length));
+          }
+          return sql_string(static_cast<const char *>(binding->buffer));
+        }
         case MYSQL_TYPE_FLOAT: {
           auto *p = static_cast<float *>(binding->buffer);
           return sql_number(*p);
@@ -268,18 +406,18 @@ namespace coda::db::mysql {
         case MYSQL_TYPE_SHORT:
         case MYSQL_TYPE_INT24:
         case MYSQL_TYPE_LONG: {
-          try {
-            return sql_number(std::stoi(std::string(value, 0, length)));
-          } catch (const std::exception &e) {
+          int number = 0;
+          if (!db::helper::parse_number(std::string_view(value, length), number)) {
             throw value_conversion_error("unable to get integer from value");
           }
+          return sql_number(number);
         }
         case MYSQL_TYPE_LONGLONG: {
-          try {
-            return sql_number(std::stoll(std::string(value, 0, length)));
-          } catch (const std::exception &e) {
+          long long number = 0;
+          if (!db::helper::parse_number(std::string_view(value, length), number)) {
             throw value_conversion_error("unable to get longlong from value");
           }
+          return sql_number(number);
         }
         case MYSQL_TYPE_DECIMAL:
         case MYSQL_TYPE_VARCHAR:
@@ -296,25 +434,25 @@ namespace coda::db::mysql {
         case MYSQL_TYPE_DATETIME:
         case MYSQL_TYPE_TIMESTAMP:
         case MYSQL_TYPE_TIME: {
-          try {
-            return sql_time(std::string(value, 0, length));
-          } catch (const value_conversion_error &e) {
+          sql_time time;
+          if (!time.parse(std::string_view(value, length))) {
             throw value_conversion_error("unable to get time format from value");
           }
+          return time;
         }
         case MYSQL_TYPE_FLOAT: {
-          try {
-            return sql_number(std::stof(std::string(value, 0, length)));
-          } catch (const std::exception &e) {
+          float number = 0;
+          if (!db::helper::parse_number(std::string_view(value, length), number)) {
             throw value_conversion_error("unable to get float from value");
           }
+          return sql_number(number);
         }
         case MYSQL_TYPE_DOUBLE: {
-          try {
-            return sql_number(std::stod(std::string(value, 0, length)));
-          } catch (const std::exception &e) {
+          double number = 0;
+          if (!db::helper::parse_number(std::string_view(value, length), number)) {
             throw value_conversion_error("unable to get double from value");
           }
+          return sql_number(number);
         }
         case MYSQL_TYPE_TINY_BLOB:
         case MYSQL_TYPE_MEDIUM_BLOB:
@@ -358,6 +496,7 @@ namespace coda::db::mysql {
       tm->hour = gmt->tm_hour;
       tm->minute = gmt->tm_min;
       tm->second = gmt->tm_sec;
+      tm->second_part = static_cast<unsigned long>(value.microseconds());
       binding->buffer = tm;
       binding->buffer_length = sizeof(MYSQL_TIME);
     }
@@ -478,16 +617,14 @@ namespace coda::db::mysql {
         *bind_->length = value.size();
       }
       void operator()(const sql_wstring &value) const {
-        typedef std::codecvt_utf8<wchar_t> convert_type;
-        std::wstring_convert<convert_type, wchar_t> converter;
-        std::string converted_str = converter.to_bytes(value);
+        std::string converted_str = db::helper::to_utf8(value);
         bind_->buffer_type = MYSQL_TYPE_STRING;
         bind_->buffer = strdup(converted_str.c_str());
-        bind_->buffer_length = value.size();
+        bind_->buffer_length = converted_str.size();
         if (!bind_->length) {
           bind_->length = c_alloc<unsigned long>();
         }
-        *bind_->length = value.size();
+        *bind_->length = converted_str.size();
       }
 
      private:
@@ -502,12 +639,81 @@ namespace coda::db::mysql {
   binding::binding(const MYSQL_BIND &value) : value_(nullptr), size_(1) { copy_value(&value, size_); }
   binding::binding(MYSQL_BIND *values, size_t size) : value_(nullptr), size_(size) { copy_value(values, size); }
 
-  binding::binding(MYSQL_FIELD *fields, size_t size) : size_(size) {
-    value_ = c_alloc<MYSQL_BIND>(size);
+  binding::binding(MYSQL_FIELD *fields, size_t size) : value_(nullptr), size_(0) { prepare_result(fields, size); }
 
-    for (size_t i = 0; i < size; i++) {
-      helper::prepare_binding_from_field(&value_[i], &fields[i]);
+  void binding::prepare_result(MYSQL_FIELD *fields, size_t size) {
+    bool reusable = value_ != nullptr && size_ == size;
+
+    for (size_t i = 0; reusable && i < size; i++) {
+      reusable = value_[i].buffer_type == fields[i].type &&
+                 (value_[i].is_null == nullptr) == ((fields[i].flags & NOT_NULL_FLAG) != 0) &&
+                 value_[i].is_unsigned == ((fields[i].flags & UNSIGNED_FLAG) != 0);
+    }
+
+    if (!reusable) {
+      clear_value();
+
+      value_ = c_alloc<MYSQL_BIND>(size);
+      size_ = size;
+
+      for (size_t i = 0; i < size; i++) {
+        helper::prepare_binding_from_field(&value_[i], &fields[i]);
+      }
+      return;
+    }
+
+    // keep the buffers, but don't hold on to large values
+    for (size_t i = 0; i < size_; i++) {
+      auto value = &value_[i];
+
+      if (value->length == nullptr || value->buffer_length <= helper::MAX_RETAINED_RESULT_SIZE) {
+        continue;
+      }
+
+      free(value->buffer);
+      value->buffer_length = helper::INITIAL_RESULT_SIZE;
+      value->buffer = c_alloc(value->buffer_length);
+    }
+  }
+
+  bool binding::fetch_truncated(MYSQL_STMT *stmt) {
+    bool fetched = false;
+
+    for (size_t i = 0; i < size_; i++) {
+      auto value = &value_[i];
+
+      if (value->length == nullptr || (value->is_null && *value->is_null) ||
+          *value->length <= value->buffer_length) {
+        continue;
+      }
+
+      // grow to the full length, plus a terminator
+      auto size = *value->length + 1;
+
+      auto buffer = realloc(value->buffer, size);
+
+      if (buffer == nullptr) {
+        throw std::bad_alloc();
+      }
+
+      value->buffer = buffer;
+      value->buffer_length = size;
+
+      memset(static_cast<char *>(value->buffer) + size - 1, 0, 1);
+
+      if (mysql_stmt_fetch_column(stmt, value, static_cast<unsigned int>(i), 0) != 0) {
+        throw database_exception(helper::last_stmt_error(stmt));
+      }
+
+      fetched = true;
     }
+
+    if (fetched) {
+      // the statement still points to the old buffers
+      bind_result(stmt);
+    }
+
+    return fetched;
   }
 
   void binding::clear_value(size_t i) {
@@ -611,6 +817,46 @@ namespace coda::db::mysql {
     return data_mapper::to_value(&value_[index]);
   }
 
+  bool binding::is_null(size_t index) const {
+    if (index >= size_ || value_ == nullptr || value_[index].buffer == nullptr) {
+      return true;
+    }
+
+    return value_[index].is_null != nullptr && *value_[index].is_null;
+  }
+
+  long long binding::to_int64(size_t index) const {
+    if (index >= size_ || value_ == nullptr) {
+      return 0;
+    }
+
+    return data_mapper::to_int64(&value_[index]);
+  }
+
+  double binding::to_double(size_t index) const {
+    if (index >= size_ || value_ == nullptr) {
+      return 0;
+    }
+
+    return data_mapper::to_double(&value_[index]);
+  }
+
+  std::string binding::to_text(size_t index) const {
+    if (index >= size_ || value_ == nullptr) {
+      return std::string();
+    }
+
+    return data_mapper::to_text(&value_[index]);
+  }
+
+  std::string_view binding::to_view(size_t index) const {
+    if (index >= size_ || value_ == nullptr) {
+      return std::string_view();
+    }
+
+    return data_mapper::to_view(&value_[index]);
+  }
+
   int binding::sql_type(size_t index) const {
     if (index >= size_ || value_ == nullptr) {
       return MYSQL_TYPE_NULL;
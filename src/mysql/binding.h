@@ -8,6 +8,7 @@
 #include <mysql/mysql.h>
 #include <set>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include "../bind_mapping.h"
 
@@ -19,6 +20,10 @@ namespace coda::db {
     namespace data_mapper {
       sql_value to_value(MYSQL_BIND *binding);
       sql_value to_value(int type, const char *value, size_t length);
+      long long to_int64(MYSQL_BIND *binding);
+      double to_double(MYSQL_BIND *binding);
+      std::string to_text(MYSQL_BIND *binding);
+      std::string_view to_view(MYSQL_BIND *binding);
     }  // namespace data_mapper
 
     /*!
@@ -93,6 +98,37 @@ namespace coda::db {
        */
       sql_value to_value(size_t index) const;
 
+      /*!
+       * @param index the index of the binding value
+       * @return true if the value at the given index is null
+       */
+      bool is_null(size_t index) const;
+
+      /*!
+       * @param index the index of the binding value
+       * @return the value at the given index as an integer, or zero if null
+       */
+      long long to_int64(size_t index) const;
+
+      /*!
+       * @param index the index of the binding value
+       * @return the value at the given index as a floating point number, or zero if null
+       */
+      double to_double(size_t index) const;
+
+      /*!
+       * @param index the index of the binding value
+       * @return the value at the given index as text, or empty if null
+       */
+      std::string to_text(size_t index) const;
+
+      /*!
+       * @param index the index of the binding value
+       * @return a view of a text or blob buffer, valid until the next fetch
+       * @throws value_conversion_error if the value is not text or a blob
+       */
+      std::string_view to_view(size_t index) const;
+
       /*!
        * @param index the index of the binding
        * @return the value type of the binding at the given index
@@ -115,6 +151,22 @@ namespace coda::db {
        */
       void bind_result(MYSQL_STMT *stmt) const;
 
+      /*!
+       * prepares the bindings to receive results for the fields,
+       * reusing the existing buffers if the fields have not changed
+       * @param fields the array of fields
+       * @param size the size of the fields array
+       */
+      void prepare_result(MYSQL_FIELD *fields, size_t size);
+
+      /*!
+       * fetches the remainder of values that did not fit their buffer
+       * after the current row was fetched, growing the buffers as needed
+       * @param stmt the raw mysql statement being fetched
+       * @return true if any values were truncated
+       */
+      bool fetch_truncated(MYSQL_STMT *stmt);
+
       /*!
        * validates the sql and prepares the bindinds
        * @param sql the sql to prepare
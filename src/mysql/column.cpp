@@ -55,6 +55,20 @@ namespace coda::db::mysql {
     return mysql::data_mapper::to_value(field->type, value_[index_], !lengths ? 0 : lengths[index_]);
   }
 
+  string_view column::to_view() const {
+    if (res_ == nullptr || value_ == nullptr) {
+      throw no_such_column_exception();
+    }
+
+    if (value_[index_] == nullptr) {
+      return string_view();
+    }
+
+    auto lengths = mysql_fetch_lengths(res_.get());
+
+    return lengths ? string_view(value_[index_], lengths[index_]) : string_view(value_[index_]);
+  }
+
   int column::sql_type() const {
     if (res_ == nullptr) {
       throw no_such_column_exception();
@@ -124,4 +138,11 @@ namespace coda::db::mysql {
   }
 
   string stmt_column::name() const { return name_; }
+
+  string_view stmt_column::to_view() const {
+    if (value_ == nullptr) {
+      throw no_such_column_exception();
+    }
+    return value_->to_view(position_);
+  }
 }  // namespace coda::db::mysql
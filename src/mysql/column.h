@@ -40,6 +40,7 @@ namespace coda::db::mysql {
     sql_value to_value() const override;
     int sql_type() const;
     std::string name() const override;
+    std::string_view to_view() const override;
   };
 
   /*!
@@ -71,6 +72,7 @@ namespace coda::db::mysql {
     sql_value to_value() const override;
     int sql_type() const;
     std::string name() const override;
+    std::string_view to_view() const override;
   };
 }  // namespace coda::db::mysql
 
@@ -1,5 +1,6 @@
 
 #include "resultset.h"
+#include "../number_format.h"
 #include "binding.h"
 #include "row.h"
 #include "session.h"
@@ -10,6 +11,37 @@ namespace coda::db::mysql {
   namespace helper {
     extern string last_stmt_error(MYSQL_STMT *stmt);
 
+    /**
+     * @cond internal
+     * @param field the field of a result
+     * @return the storage type for the field in a batch
+     */
+    batch_column::type batch_type(MYSQL_FIELD *field) {
+      if (field == nullptr) {
+        return batch_column::text;
+      }
+
+      switch (field->type) {
+        case MYSQL_TYPE_TINY:
+        case MYSQL_TYPE_SHORT:
+        case MYSQL_TYPE_INT24:
+        case MYSQL_TYPE_LONG:
+        case MYSQL_TYPE_LONGLONG:
+          return batch_column::integer;
+        case MYSQL_TYPE_FLOAT:
+        case MYSQL_TYPE_DOUBLE:
+          return batch_column::real;
+        case MYSQL_TYPE_TINY_BLOB:
+        case MYSQL_TYPE_MEDIUM_BLOB:
+        case MYSQL_TYPE_LONG_BLOB:
+        case MYSQL_TYPE_BLOB:
+          // text columns are blobs with a character set
+          return field->charsetnr == 63 ? batch_column::blob : batch_column::text;
+        default:
+          return batch_column::text;
+      }
+    }
+
     /**
      * @cond internal
      * @param p the result
@@ -21,8 +53,8 @@ namespace coda::db::mysql {
     }
   }  // namespace helper
 
-  resultset::resultset(const std::shared_ptr<mysql::session> &sess, const shared_ptr<MYSQL_RES> &res)
-      : res_(res), row_(nullptr), sess_(sess) {
+  resultset::resultset(const std::shared_ptr<mysql::session> &sess, const shared_ptr<MYSQL_RES> &res, bool streaming)
+      : res_(res), row_(nullptr), sess_(sess), streaming_(streaming), fetched_(false) {
     if (sess_ == nullptr) {
       throw database_exception("database not provided to mysql resultset");
     }
@@ -42,20 +74,172 @@ namespace coda::db::mysql {
 
     row_ = mysql_fetch_row(res_.get());
 
+    fetched_ = true;
+
+    if (row_ == nullptr && streaming_) {
+      // the last row has been read, so the connection can be used again
+      if (sess_->streaming_.lock() == res_) {
+        sess_->streaming_.reset();
+      }
+
+      if (mysql_errno(sess_->db_.get())) {
+        throw database_exception(sess_->last_error());
+      }
+    }
+
     return row_ != nullptr;
   }
 
   void resultset::reset() {
-    if (res_ != nullptr) {
+    if (res_ == nullptr) {
+      return;
+    }
+
+    if (!streaming_) {
       mysql_data_seek(res_.get(), 0);
+    } else if (fetched_) {
+      throw database_exception("streaming results can only be read once");
+    }
+  }
+
+  resultset::row_type resultset::current_row() { return row_type(make_shared<mysql::row>(sess_, res_, row_, columns())); }
+
+  size_t resultset::column_count() { return is_valid() ? mysql_num_fields(res_.get()) : 0; }
+
+  size_t resultset::row_count() {
+    if (!is_valid()) {
+      return 0;
+    }
+
+    // streamed rows are only counted once they have all been read
+    if (streaming_) {
+      return npos;
+    }
+
+    return static_cast<size_t>(mysql_num_rows(res_.get()));
+  }
+
+  sql_value resultset::column_value(size_t index) {
+    if (index >= column_count() || row_ == nullptr) {
+      throw no_such_column_exception();
+    }
+
+    auto field = mysql_fetch_field_direct(res_.get(), static_cast<unsigned int>(index));
+
+    auto lengths = mysql_fetch_lengths(res_.get());
+
+    return data_mapper::to_value(field->type, row_[index], !lengths ? 0 : lengths[index]);
+  }
+
+  string resultset::column_name(size_t index) {
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+
+    auto field = mysql_fetch_field_direct(res_.get(), static_cast<unsigned int>(index));
+
+    return field == nullptr || field->name == nullptr ? string() : field->name;
+  }
+
+  bool resultset::column_is_null(size_t index) {
+    if (index >= column_count() || row_ == nullptr) {
+      throw no_such_column_exception();
+    }
+    return row_[index] == nullptr;
+  }
+
+  long long resultset::column_int64(size_t index) {
+    if (column_is_null(index)) {
+      return 0;
+    }
+
+    switch (mysql_fetch_field_direct(res_.get(), static_cast<unsigned int>(index))->type) {
+      case MYSQL_TYPE_TINY:
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_INT24:
+      case MYSQL_TYPE_LONG:
+      case MYSQL_TYPE_LONGLONG: {
+        long long value = 0;
+        if (db::helper::parse_number(column_data(index), value)) {
+          return value;
+        }
+        break;
+      }
+      case MYSQL_TYPE_FLOAT:
+      case MYSQL_TYPE_DOUBLE:
+      case MYSQL_TYPE_DECIMAL:
+      case MYSQL_TYPE_NEWDECIMAL: {
+        double value = 0;
+        if (db::helper::parse_number(column_data(index), value)) {
+          return static_cast<long long>(value);
+        }
+        break;
+      }
+      default:
+        break;
+    }
+    return resultset_impl::column_int64(index);
+  }
+
+  double resultset::column_double(size_t index) {
+    if (column_is_null(index)) {
+      return 0;
+    }
+
+    switch (mysql_fetch_field_direct(res_.get(), static_cast<unsigned int>(index))->type) {
+      case MYSQL_TYPE_TINY:
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_INT24:
+      case MYSQL_TYPE_LONG:
+      case MYSQL_TYPE_LONGLONG:
+      case MYSQL_TYPE_FLOAT:
+      case MYSQL_TYPE_DOUBLE:
+      case MYSQL_TYPE_DECIMAL:
+      case MYSQL_TYPE_NEWDECIMAL: {
+        double value = 0;
+        if (db::helper::parse_number(column_data(index), value)) {
+          return value;
+        }
+        break;
+      }
+      default:
+        break;
     }
+    return resultset_impl::column_double(index);
+  }
+
+  string resultset::column_text(size_t index) {
+    if (column_is_null(index)) {
+      return string();
+    }
+
+    auto lengths = mysql_fetch_lengths(res_.get());
+
+    return lengths ? string(row_[index], lengths[index]) : string(row_[index]);
+  }
+
+  string_view resultset::column_data(size_t index) {
+    if (column_is_null(index)) {
+      return string_view();
+    }
+
+    auto lengths = mysql_fetch_lengths(res_.get());
+
+    return lengths ? string_view(row_[index], lengths[index]) : string_view(row_[index]);
+  }
+
+  batch_column::type resultset::batch_type(size_t index) {
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+    return helper::batch_type(mysql_fetch_field_direct(res_.get(), static_cast<unsigned int>(index)));
   }
 
-  resultset::row_type resultset::current_row() { return row_type(make_shared<mysql::row>(sess_, res_, row_)); }
   /* Statement version */
 
-  stmt_resultset::stmt_resultset(const std::shared_ptr<mysql::session> &sess, const shared_ptr<MYSQL_STMT> &stmt)
-      : stmt_(stmt), metadata_(nullptr), sess_(sess), bindings_(nullptr), status_(-1) {
+  stmt_resultset::stmt_resultset(const std::shared_ptr<mysql::session> &sess, const shared_ptr<MYSQL_STMT> &stmt,
+                                 const shared_ptr<mysql::binding> &results)
+      : stmt_(stmt), metadata_(nullptr), sess_(sess), bindings_(results), status_(-1) {
     if (stmt_ == nullptr) {
       throw database_exception("invalid statement provided to mysql statement resultset");
     }
@@ -86,7 +270,11 @@ namespace coda::db::mysql {
 
     auto fields = mysql_fetch_fields(temp);
 
-    bindings_ = make_shared<mysql::binding>(fields, size);
+    if (bindings_ == nullptr) {
+      bindings_ = make_shared<mysql::binding>(fields, size);
+    } else {
+      bindings_->prepare_result(fields, size);
+    }
 
     bindings_->bind_result(stmt_.get());
   }
@@ -109,17 +297,19 @@ namespace coda::db::mysql {
 
     int res = mysql_stmt_fetch(stmt_.get());
 
+    // values larger than their buffer are fetched again into a bigger one
+    if (res == MYSQL_DATA_TRUNCATED && bindings_->fetch_truncated(stmt_.get())) {
+      res = 0;
+    }
+
     if (res == 1 || res == MYSQL_DATA_TRUNCATED) {
       throw database_exception(helper::last_stmt_error(stmt_.get()));
     }
 
     return res != MYSQL_NO_DATA;
-
   }
 
   void stmt_resultset::reset() {
-    bindings_.reset();
-
     if (!is_valid()) {
       // mysql stmt resultset reset invalid
       return;
@@ -133,6 +323,67 @@ namespace coda::db::mysql {
   }
 
   resultset::row_type stmt_resultset::current_row() {
-    return row_type(make_shared<stmt_row>(sess_, stmt_, metadata_, bindings_));
+    return row_type(make_shared<stmt_row>(sess_, stmt_, metadata_, bindings_, columns()));
+  }
+
+  size_t stmt_resultset::column_count() { return metadata_ == nullptr ? 0 : mysql_num_fields(metadata_.get()); }
+
+  sql_value stmt_resultset::column_value(size_t index) {
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+    return bindings_->to_value(index);
+  }
+
+  string stmt_resultset::column_name(size_t index) {
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+
+    auto field = mysql_fetch_field_direct(metadata_.get(), static_cast<unsigned int>(index));
+
+    return field == nullptr || field->name == nullptr ? string() : field->name;
+  }
+
+  bool stmt_resultset::column_is_null(size_t index) {
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+    return bindings_->is_null(index);
+  }
+
+  long long stmt_resultset::column_int64(size_t index) {
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+    return bindings_->to_int64(index);
+  }
+
+  double stmt_resultset::column_double(size_t index) {
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+    return bindings_->to_double(index);
+  }
+
+  string_view stmt_resultset::column_data(size_t index) {
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+    return bindings_->to_view(index);
+  }
+
+  batch_column::type stmt_resultset::batch_type(size_t index) {
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+    return helper::batch_type(mysql_fetch_field_direct(metadata_.get(), static_cast<unsigned int>(index)));
+  }
+
+  string stmt_resultset::column_text(size_t index) {
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+    return bindings_->to_text(index);
   }
 }  // namespace coda::db::mysql
@@ -22,13 +22,19 @@ namespace coda::db::mysql {
     std::shared_ptr<MYSQL_RES> res_;
     MYSQL_ROW row_;
     std::shared_ptr<mysql::session> sess_;
+    bool streaming_;
+    bool fetched_;
 
    public:
     /*!
      * @param db the database in use
      * @param res the query results
+     * @param streaming true if the results are read from the server as needed.
+     *                  streaming results can only be iterated once, and unread rows
+     *                  are discarded when the results are released.
      */
-    resultset(const std::shared_ptr<mysql::session> &sess, const std::shared_ptr<MYSQL_RES> &res);
+    resultset(const std::shared_ptr<mysql::session> &sess, const std::shared_ptr<MYSQL_RES> &res,
+              bool streaming = false);
 
     /* non-copyable boilerplate */
     resultset(const resultset &other) = delete;
@@ -42,6 +48,20 @@ namespace coda::db::mysql {
     resultset::row_type current_row() override;
     void reset() override;
     bool next() override;
+    size_t column_count() override;
+    sql_value column_value(size_t index) override;
+    std::string column_name(size_t index) override;
+    bool column_is_null(size_t index) override;
+    long long column_int64(size_t index) override;
+    double column_double(size_t index) override;
+    std::string column_text(size_t index) override;
+    std::string_view column_data(size_t index) override;
+    batch_column::type batch_type(size_t index) override;
+
+    /*!
+     * @return the number of rows, or npos when streaming
+     */
+    size_t row_count() override;
   };
 
   /*!
@@ -63,8 +83,10 @@ namespace coda::db::mysql {
     /*!
      * @param db the database in use
      * @param stmt the statement being executed
+     * @param results the result buffers to reuse, if any
      */
-    stmt_resultset(const std::shared_ptr<mysql::session> &sess, const std::shared_ptr<MYSQL_STMT> &stmt);
+    stmt_resultset(const std::shared_ptr<mysql::session> &sess, const std::shared_ptr<MYSQL_STMT> &stmt,
+                   const std::shared_ptr<mysql::binding> &results = nullptr);
 
     /* non-copyable boilerplate */
     stmt_resultset(const stmt_resultset &other) = delete;
@@ -80,6 +102,15 @@ namespace coda::db::mysql {
     stmt_resultset::row_type current_row() override;
     void reset() override;
     bool next() override;
+    size_t column_count() override;
+    sql_value column_value(size_t index) override;
+    std::string column_name(size_t index) override;
+    bool column_is_null(size_t index) override;
+    long long column_int64(size_t index) override;
+    double column_double(size_t index) override;
+    std::string column_text(size_t index) override;
+    std::string_view column_data(size_t index) override;
+    batch_column::type batch_type(size_t index) override;
   };
 
   namespace helper {
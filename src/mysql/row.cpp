@@ -7,8 +7,9 @@
 using namespace std;
 
 namespace coda::db::mysql {
-  row::row(const std::shared_ptr<mysql::session> &sess, const shared_ptr<MYSQL_RES> &res, MYSQL_ROW row)
-      : row_impl(), row_(row), res_(res), sess_(sess) {
+  row::row(const std::shared_ptr<mysql::session> &sess, const shared_ptr<MYSQL_RES> &res, MYSQL_ROW row,
+           const shared_ptr<column_index> &columns)
+      : row_impl(), row_(row), res_(res), sess_(sess), columns_(columns) {
     if (sess_ == nullptr) {
       throw database_exception("no database provided for mysql row");
     }
@@ -45,6 +46,16 @@ namespace coda::db::mysql {
       throw no_such_column_exception();
     }
 
+    if (columns_ != nullptr) {
+      auto index = columns_->find(name);
+
+      if (index == column_index::npos) {
+        throw no_such_column_exception(name);
+      }
+
+      return column(index);
+    }
+
     for (size_t i = 0; i < size_; i++) {
       auto field = mysql_fetch_field_direct(res_.get(), i);
 
@@ -80,8 +91,9 @@ namespace coda::db::mysql {
   /* statement version */
 
   stmt_row::stmt_row(const std::shared_ptr<mysql::session> &sess, const shared_ptr<MYSQL_STMT> &stmt,
-                     const shared_ptr<MYSQL_RES> &metadata, const shared_ptr<mysql::binding> &fields)
-      : row_impl(), fields_(fields), metadata_(metadata), stmt_(stmt), sess_(sess), size_(0) {
+                     const shared_ptr<MYSQL_RES> &metadata, const shared_ptr<mysql::binding> &fields,
+                     const shared_ptr<column_index> &columns)
+      : row_impl(), fields_(fields), metadata_(metadata), stmt_(stmt), sess_(sess), columns_(columns), size_(0) {
     if (sess_ == nullptr) {
       throw database_exception("No database provided for mysql row");
     }
@@ -97,6 +109,7 @@ namespace coda::db::mysql {
         metadata_(std::move(other.metadata_)),
         stmt_(std::move(other.stmt_)),
         sess_(std::move(other.sess_)),
+        columns_(std::move(other.columns_)),
         size_(other.size_) {
     other.sess_ = nullptr;
     other.fields_ = nullptr;
@@ -108,6 +121,7 @@ namespace coda::db::mysql {
     fields_ = std::move(other.fields_);
     metadata_ = std::move(other.metadata_);
     sess_ = std::move(other.sess_);
+    columns_ = std::move(other.columns_);
     size_ = other.size_;
     stmt_ = std::move(other.stmt_);
     other.sess_ = nullptr;
@@ -139,6 +153,16 @@ namespace coda::db::mysql {
       throw no_such_column_exception();
     }
 
+    if (columns_ != nullptr) {
+      auto index = columns_->find(name);
+
+      if (index == column_index::npos) {
+        throw no_such_column_exception(name);
+      }
+
+      return column(index);
+    }
+
     for (size_t i = 0; i < size(); i++) {
       auto field = mysql_fetch_field_direct(metadata_.get(), i);
 
@@ -7,6 +7,7 @@
 
 #include <mysql/mysql.h>
 #include <vector>
+#include "../column_index.h"
 #include "../row.h"
 
 namespace coda::db::mysql {
@@ -21,6 +22,7 @@ namespace coda::db::mysql {
     MYSQL_ROW row_;
     std::shared_ptr<MYSQL_RES> res_;
     std::shared_ptr<mysql::session> sess_;
+    std::shared_ptr<column_index> columns_;
     size_t size_;
 
    public:
@@ -28,8 +30,10 @@ namespace coda::db::mysql {
      * @param db the database in use
      * @param res the query result
      * @param row the row values
+     * @param columns the shared column name index, if any
      */
-    row(const std::shared_ptr<mysql::session> &db, const std::shared_ptr<MYSQL_RES> &res, MYSQL_ROW row);
+    row(const std::shared_ptr<mysql::session> &db, const std::shared_ptr<MYSQL_RES> &res, MYSQL_ROW row,
+        const std::shared_ptr<column_index> &columns = nullptr);
 
     /* non-copyable boilerplate */
     ~row() override = default;
@@ -55,6 +59,7 @@ namespace coda::db::mysql {
     std::shared_ptr<MYSQL_RES> metadata_;
     std::shared_ptr<MYSQL_STMT> stmt_;
     std::shared_ptr<mysql::session> sess_;
+    std::shared_ptr<column_index> columns_;
     size_t size_;
 
    public:
@@ -63,9 +68,11 @@ namespace coda::db::mysql {
      * @param stmt the query statement
      * @param metadata the query meta data
      * @param fields the bindings for the statement
+     * @param columns the shared column name index, if any
      */
     stmt_row(const std::shared_ptr<mysql::session> &sess, const std::shared_ptr<MYSQL_STMT> &stmt,
-             const std::shared_ptr<MYSQL_RES> &metadata, const std::shared_ptr<mysql::binding> &fields);
+             const std::shared_ptr<MYSQL_RES> &metadata, const std::shared_ptr<mysql::binding> &fields,
+             const std::shared_ptr<column_index> &columns = nullptr);
 
     /* non-copyable boilerplate */
     ~stmt_row() override = default;
@@ -42,7 +42,7 @@ namespace coda::db::mysql {
 
   std::shared_ptr<coda::db::session_impl> factory::create(const uri &uri) { return std::make_shared<session>(uri); }
 
-  session::session(const uri &connInfo) : session_impl(connInfo), db_(nullptr) {}
+  session::session(const uri &connInfo) : session_impl(connInfo), streamingResults_(false), db_(nullptr) {}
 
   session::~session() {
     if (is_open()) {
@@ -91,6 +91,7 @@ namespace coda::db::mysql {
     if (db_ != nullptr) {
       db_ = nullptr;
     }
+    streaming_.reset();
   }
 
   string session::last_error() const {
@@ -122,24 +123,44 @@ namespace coda::db::mysql {
     return mysql_affected_rows(db_.get());
   }
 
-  std::shared_ptr<resultset_impl> session::query(const string &sql) {
+  std::shared_ptr<resultset_impl> session::query(const string &sql) { return query(sql, streamingResults_); }
+
+  std::shared_ptr<resultset_impl> session::query(const string &sql, bool streaming) {
     MYSQL_RES *res = nullptr;
 
     if (db_ == nullptr) {
       throw database_exception("database is not open");
     }
 
+    assert_not_streaming();
+
     if (mysql_real_query(db_.get(), sql.c_str(), sql.length())) {
       throw database_exception(last_error());
     }
 
-    res = mysql_store_result(db_.get());
+    res = streaming ? mysql_use_result(db_.get()) : mysql_store_result(db_.get());
 
     if (res == nullptr && mysql_field_count(db_.get()) != 0) {
       throw database_exception(last_error());
     }
 
-    return make_shared<resultset>(shared_from_this(), shared_ptr<MYSQL_RES>(res, helper::res_delete()));
+    auto value = shared_ptr<MYSQL_RES>(res, helper::res_delete());
+
+    if (streaming && value != nullptr) {
+      streaming_ = value;
+    }
+
+    return make_shared<resultset>(shared_from_this(), value, streaming);
+  }
+
+  bool session::streaming_results() const noexcept { return streamingResults_; }
+
+  void session::set_streaming_results(bool value) noexcept { streamingResults_ = value; }
+
+  void session::assert_not_streaming() const {
+    if (!streaming_.expired()) {
+      throw database_exception("a streaming result is still being read on this connection");
+    }
   }
 
   bool session::execute(const string &sql) {
@@ -147,6 +168,8 @@ namespace coda::db::mysql {
       throw database_exception("database is not open");
     }
 
+    assert_not_streaming();
+
     return !mysql_real_query(db_.get(), sql.c_str(), sql.length());
   }
 
@@ -237,6 +260,15 @@ namespace coda::db::mysql {
 
   std::string session::bind_param(size_t) const { return "?"; }
 
-  constexpr int session::features() const { return db::session::FEATURE_RIGHT_JOIN; }
+  constexpr int session::features() const {
+    return db::session::FEATURE_RIGHT_JOIN | db::session::FEATURE_ON_DUPLICATE_KEY;
+  }
+
+  // the protocol uses a 16 bit parameter count
+  size_t session::max_bind_params() const { return 65535; }
+
+  bool session::in_transaction() const noexcept {
+    return db_ != nullptr && (db_->server_status & SERVER_STATUS_IN_TRANS) != 0;
+  }
 
 }  // namespace coda::db::mysql
@@ -27,6 +27,8 @@ namespace coda::db::mysql {
 
    private:
     std::vector<std::string> get_primary_keys(const std::string &dbName, const std::string &tableName);
+    std::weak_ptr<MYSQL_RES> streaming_;
+    bool streamingResults_;
 
    protected:
     std::shared_ptr<MYSQL> db_;
@@ -60,6 +62,35 @@ namespace coda::db::mysql {
                                                           const std::string &tablename) override;
     std::string bind_param(size_t index) const override;
     [[nodiscard]] constexpr int features() const override;
+    size_t max_bind_params() const override;
+    bool in_transaction() const noexcept override;
+
+    /*!
+     * queries the database
+     * @param sql       the sql to execute
+     * @param streaming true to read rows from the server as they are needed instead of
+     *                  storing the whole result in memory
+     * @return the results of the query
+     */
+    std::shared_ptr<resultset_impl> query(const std::string &sql, bool streaming);
+
+    /*!
+     * @return true if queries stream their results by default
+     */
+    bool streaming_results() const noexcept;
+
+    /*!
+     * sets the default result mode for queries.  a streaming result holds the
+     * connection until it is read to the end or released, and any other query
+     * on the session before then will throw.
+     * @param value true to stream results
+     */
+    void set_streaming_results(bool value) noexcept;
+
+    /*!
+     * @throws database_exception if a streaming result is still being read
+     */
+    void assert_not_streaming() const;
   };
 }  // namespace coda::db::mysql
 
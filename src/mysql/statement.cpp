@@ -32,6 +32,8 @@ namespace coda::db::mysql {
       throw database_exception("database is not open");
     }
 
+    sess_->assert_not_streaming();
+
     MYSQL_STMT *temp = mysql_stmt_init(sess_->db_.get());
 
     if (temp == nullptr) {
@@ -49,6 +51,8 @@ namespace coda::db::mysql {
 
   bool statement::is_valid() const noexcept { return stmt_ != nullptr && stmt_; }
 
+  bool statement::is_busy() const noexcept { return stmt_ != nullptr && stmt_.use_count() > 1; }
+
   /**
    * binding methods ensure the dynamic array is sized properly and store
    * the value as a memory pointer
@@ -68,9 +72,16 @@ namespace coda::db::mysql {
       throw database_exception("statement not ready");
     }
 
+    sess_->assert_not_streaming();
+
     bindings_.bind_params(stmt_.get());
 
-    return resultset_type(make_shared<stmt_resultset>(sess_, stmt_));
+    // result buffers are kept with the statement so they can be reused by the next execution
+    if (results_ == nullptr) {
+      results_ = make_shared<binding>(0);
+    }
+
+    return resultset_type(make_shared<stmt_resultset>(sess_, stmt_, results_));
   }
 
   bool statement::execute() {
@@ -79,6 +90,8 @@ namespace coda::db::mysql {
       return false;
     }
 
+    sess_->assert_not_streaming();
+
     bindings_.bind_params(stmt_.get());
 
     return mysql_stmt_execute(stmt_.get()) == 0;
@@ -103,6 +116,7 @@ namespace coda::db::mysql {
 
   void statement::finish() {
     bindings_.reset();
+    results_ = nullptr;
 
     if (stmt_ != nullptr) {
       mysql_stmt_free_result(stmt_.get());
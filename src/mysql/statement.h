@@ -20,6 +20,7 @@ namespace coda::db::mysql {
     std::shared_ptr<session> sess_;
     std::shared_ptr<MYSQL_STMT> stmt_;
     binding bindings_;
+    std::shared_ptr<binding> results_;
 
    public:
     /*!
@@ -37,6 +38,7 @@ namespace coda::db::mysql {
     /* statement overrides */
     void prepare(const std::string &sql) override;
     bool is_valid() const noexcept override;
+    bool is_busy() const noexcept override;
     resultset_type query() override;
     bool execute() override;
     void finish() override;
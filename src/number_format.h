@@ -0,0 +1,84 @@
+/*!
+ * @file number_format.h
+ * @abstract Locale independent conversion between numbers and text
+ * @discussion Built on std::to_chars and std::from_chars, so conversions do not throw or allocate, and floating
+ * point values are formatted in the shortest form that parses back to the same value.
+ */
+#ifndef CODA_DB_NUMBER_FORMAT_H
+#define CODA_DB_NUMBER_FORMAT_H
+
+#include <cctype>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace coda::db::helper {
+  /*!
+   * a buffer size large enough to format any number
+   */
+  constexpr static const size_t NUMBER_BUFFER_SIZE = 64;
+
+  /*!
+   * formats a number as text
+   * @param first the start of the buffer
+   * @param last the end of the buffer
+   * @param value the number to format
+   * @return the end of the formatted text, or nullptr if the buffer is too small
+   */
+  template<typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+  char *format_number(char *first, char *last, const T &value) noexcept {
+    // promotes booleans and characters to integers
+    auto result = std::to_chars(first, last, +value);
+
+    return result.ec == std::errc() ? result.ptr : nullptr;
+  }
+
+  /*!
+   * formats a number as text
+   * @param value the number to format
+   * @return the formatted text
+   */
+  template<typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+  std::string format_number(const T &value) {
+    char buf[NUMBER_BUFFER_SIZE];
+
+    auto end = format_number(buf, buf + sizeof(buf), value);
+
+    return std::string(buf, end == nullptr ? 0 : static_cast<size_t>(end - buf));
+  }
+
+  /*!
+   * parses text as a number
+   * leading and trailing whitespace and a leading plus sign are allowed, anything else must be part of the number
+   * @param text the text to parse
+   * @param value the parsed number, unchanged on failure
+   * @return true if the text was a number within the range of the type
+   */
+  template<typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>>
+  bool parse_number(std::string_view text, T &value) noexcept {
+    auto first = text.data();
+    auto last = first + text.size();
+
+    while (first < last && isspace(static_cast<unsigned char>(*first))) {
+      first++;
+    }
+    while (last > first && isspace(static_cast<unsigned char>(*(last - 1)))) {
+      last--;
+    }
+    if (first < last && *first == '+' && (last - first) > 1 && *(first + 1) != '-') {
+      first++;
+    }
+
+    T result;
+    auto parsed = std::from_chars(first, last, result);
+
+    if (parsed.ec != std::errc() || parsed.ptr != last) {
+      return false;
+    }
+    value = result;
+    return true;
+  }
+}  // namespace coda::db::helper
+
+#endif
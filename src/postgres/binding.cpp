@@ -1,9 +1,12 @@
 
+#include <arpa/inet.h>
 #include <time.h>
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <regex>
+#include <vector>
 #include <libpq-fe.h>
 #include <postgres.h>
 
@@ -11,6 +14,7 @@
 
 #include "../alloc.h"
 #include "../exception.h"
+#include "../number_format.h"
 #include "../sql_value.h"
 #include "binding.h"
 
@@ -38,25 +42,39 @@ namespace coda::db::postgres {
             case INT8OID:
             case INT2OID:
             case INT4OID:
-            case TIMESTAMPOID:
-            case BITOID:
-              try {
-                return sql_number(stol(value));
-              } catch (const std::exception &e) {
+            case BITOID: {
+              long number = 0;
+              if (!helper::parse_number(value, number)) {
                 throw database_exception("invalid number: " + string(value));
               }
-            case FLOAT4OID:
-              try {
-                return sql_number(stod(value));
-              } catch (const std::exception &e) {
+              return sql_number(number);
+            }
+            case FLOAT4OID: {
+              double number = 0;
+              if (!helper::parse_number(value, number)) {
                 throw database_exception("invalid floating point: " + string(value));
               }
-            case FLOAT8OID:
-              try {
-                return sql_number(stold(value));
-              } catch (const std::exception &e) {
+              return sql_number(number);
+            }
+            case FLOAT8OID: {
+              long double number = 0;
+              if (!helper::parse_number(value, number)) {
                 throw database_exception("invalid floating point: " + string(value));
               }
+              return sql_number(number);
+            }
+            case TIMESTAMPOID:
+            case TIMESTAMPTZOID: {
+              sql_time time;
+              if (time.parse(value)) {
+                return time;
+              }
+              long number = 0;
+              if (!helper::parse_number(value, number)) {
+                throw database_exception("invalid timestamp: " + string(value));
+              }
+              return sql_number(number);
+            }
             case UNKNOWNOID:
               return nullptr;
             case VARCHAROID:
@@ -70,6 +88,350 @@ namespace coda::db::postgres {
           }
         }
 
+        namespace binary {
+          const int16_t NUMERIC_NEG = 0x4000;
+          const uint16_t NUMERIC_NAN = 0xC000;
+
+          int16_t get_int16(const char *value) {
+            uint16_t n;
+            memcpy(&n, value, sizeof(n));
+            return static_cast<int16_t>(ntohs(n));
+          }
+
+          int32_t get_int32(const char *value) {
+            uint32_t n;
+            memcpy(&n, value, sizeof(n));
+            return static_cast<int32_t>(ntohl(n));
+          }
+
+          int64_t get_int64(const char *value) {
+            uint64_t hi = static_cast<uint32_t>(get_int32(value));
+            uint64_t lo = static_cast<uint32_t>(get_int32(value + 4));
+            return static_cast<int64_t>((hi << 32) | lo);
+          }
+
+          void assert_length(const char *name, int len, int expected) {
+            if (len != expected) {
+              throw database_exception("invalid binary " + string(name) + " of length " + std::to_string(len));
+            }
+          }
+
+          /*!
+           * numerics are base 10000 digits with a weight for the first digit,
+           * decoded to the same decimal string as the text format
+           */
+          sql_value to_numeric(const char *value, int len) {
+            if (len < 8) {
+              throw database_exception("invalid binary numeric");
+            }
+
+            auto ndigits = get_int16(value);
+            auto weight = get_int16(value + 2);
+            auto sign = static_cast<uint16_t>(get_int16(value + 4));
+            auto dscale = get_int16(value + 6);
+
+            if (sign == NUMERIC_NAN) {
+              return sql_string("NaN");
+            }
+
+            if (len < 8 + ndigits * 2) {
+              throw database_exception("invalid binary numeric");
+            }
+
+            auto digit = [&](int i) { return i >= 0 && i < ndigits ? get_int16(value + 8 + i * 2) : 0; };
+
+            string buf;
+
+            if (sign == NUMERIC_NEG) {
+              buf += '-';
+            }
+
+            if (weight < 0) {
+              buf += '0';
+            } else {
+              for (int i = 0; i <= weight; i++) {
+                auto d = std::to_string(digit(i));
+                // leading digit is not padded
+                if (i > 0) {
+                  buf.append(4 - d.size(), '0');
+                }
+                buf += d;
+              }
+            }
+
+            if (dscale > 0) {
+              buf += '.';
+
+              string fraction;
+
+              for (int i = weight + 1; static_cast<int>(fraction.size()) < dscale; i++) {
+                auto d = std::to_string(digit(i));
+                fraction.append(4 - d.size(), '0');
+                fraction += d;
+              }
+
+              buf.append(fraction, 0, dscale);
+            }
+
+            return sql_string(buf);
+          }
+
+          sql_value to_uuid(const char *value, int len) {
+            static const char hex[] = "0123456789abcdef";
+
+            assert_length("uuid", len, 16);
+
+            string buf;
+
+            for (int i = 0; i < 16; i++) {
+              if (i == 4 || i == 6 || i == 8 || i == 10) {
+                buf += '-';
+              }
+              auto c = static_cast<unsigned char>(value[i]);
+              buf += hex[c >> 4];
+              buf += hex[c & 0x0F];
+            }
+
+            return sql_string(buf);
+          }
+
+          // decodes a value in network byte order, types without a decoder are returned as blobs
+          sql_value to_value(Oid type, const char *value, int len) {
+            switch (type) {
+              case BOOLOID:
+                assert_length("bool", len, 1);
+                return sql_number(value[0] != 0);
+              case CHAROID:
+                assert_length("char", len, 1);
+                return sql_number(value[0]);
+              case INT2OID:
+                assert_length("int2", len, 2);
+                return sql_number(get_int16(value));
+              case INT4OID:
+                assert_length("int4", len, 4);
+                return sql_number(get_int32(value));
+              case INT8OID:
+                assert_length("int8", len, 8);
+                return sql_number(static_cast<long long>(get_int64(value)));
+              case FLOAT4OID: {
+                assert_length("float4", len, 4);
+                auto bits = get_int32(value);
+                float f;
+                memcpy(&f, &bits, sizeof(f));
+                return sql_number(f);
+              }
+              case FLOAT8OID: {
+                assert_length("float8", len, 8);
+                auto bits = get_int64(value);
+                double d;
+                memcpy(&d, &bits, sizeof(d));
+                return sql_number(d);
+              }
+              case TIMESTAMPOID:
+              case TIMESTAMPTZOID: {
+                assert_length("timestamp", len, 8);
+                auto micros = get_int64(value) + POSTGRES_EPOCH_OFFSET * 1000000LL;
+                return sql_time(sql_time::time_point(std::chrono::microseconds(micros)), sql_time::TIMESTAMP);
+              }
+              case DATEOID: {
+                assert_length("date", len, 4);
+                auto days = static_cast<long long>(get_int32(value));
+                return sql_time(static_cast<time_t>(days * 86400 + POSTGRES_EPOCH_OFFSET), sql_time::DATE);
+              }
+              case TIMEOID: {
+                assert_length("time", len, 8);
+                auto micros = get_int64(value);
+                return sql_time(sql_time::time_point(std::chrono::microseconds(micros)), sql_time::TIME);
+              }
+              case NUMERICOID:
+                return to_numeric(value, len);
+              case UUIDOID:
+                return to_uuid(value, len);
+              case UNKNOWNOID:
+                return nullptr;
+              case VARCHAROID:
+              case TEXTOID:
+              case BPCHAROID:
+              case NAMEOID:
+                return sql_string(value, len);
+              case BYTEAOID:
+              default:
+                return sql_blob(value, len);
+            }
+          }
+        }  // namespace binary
+
+        sql_value to_value(Oid type, const char *value, int len, int format) {
+          if (format == 0) {
+            return to_value(type, value, len);
+          }
+
+          if (value == nullptr) {
+            return sql_null;
+          }
+
+          return binary::to_value(type, value, len);
+        }
+
+        int32_t to_binary_date(const sql_time &value) {
+          auto seconds = static_cast<long long>(value.value()) - POSTGRES_EPOCH_OFFSET;
+          // round towards the earlier day
+          return static_cast<int32_t>(seconds >= 0 ? seconds / 86400 : (seconds - 86399) / 86400);
+        }
+
+        int64_t to_binary_time(const sql_time &value) {
+          constexpr static const long long MICROS_PER_DAY = 86400LL * 1000000LL;
+          auto of_day = static_cast<long long>(value.to_time_point().time_since_epoch().count()) % MICROS_PER_DAY;
+          return of_day < 0 ? of_day + MICROS_PER_DAY : of_day;
+        }
+
+        int64_t to_binary_timestamp(const sql_time &value) {
+          auto micros = static_cast<long long>(value.to_time_point().time_since_epoch().count());
+          return micros - POSTGRES_EPOCH_OFFSET * 1000000LL;
+        }
+
+        /*
+         * the typed decoders read common types straight from the result,
+         * other types are converted through a value
+         */
+        long long to_int64(Oid type, const char *value, int len, int format) {
+          if (value == nullptr) {
+            return 0;
+          }
+
+          if (format == 0) {
+            switch (type) {
+              case BOOLOID:
+                return value[0] == 't' ? 1 : 0;
+              case INT2OID:
+              case INT4OID:
+              case INT8OID: {
+                long long number = 0;
+                if (helper::parse_number(value, number)) {
+                  return number;
+                }
+                break;
+              }
+              case FLOAT4OID:
+              case FLOAT8OID:
+              case NUMERICOID: {
+                double number = 0;
+                if (helper::parse_number(value, number)) {
+                  return static_cast<long long>(number);
+                }
+                break;
+              }
+              default:
+                break;
+            }
+          } else {
+            switch (type) {
+              case BOOLOID:
+              case CHAROID:
+                binary::assert_length("char", len, 1);
+                return value[0];
+              case INT2OID:
+                binary::assert_length("int2", len, 2);
+                return binary::get_int16(value);
+              case INT4OID:
+                binary::assert_length("int4", len, 4);
+                return binary::get_int32(value);
+              case INT8OID:
+                binary::assert_length("int8", len, 8);
+                return binary::get_int64(value);
+              case FLOAT4OID:
+              case FLOAT8OID:
+                return static_cast<long long>(to_double(type, value, len, format));
+              default:
+                break;
+            }
+          }
+
+          auto result = to_value(type, value, len, format);
+
+          return result == sql_null ? 0 : result.as<long long>();
+        }
+
+        double to_double(Oid type, const char *value, int len, int format) {
+          if (value == nullptr) {
+            return 0;
+          }
+
+          if (format == 0) {
+            switch (type) {
+              case BOOLOID:
+                return value[0] == 't' ? 1 : 0;
+              case INT2OID:
+              case INT4OID:
+              case INT8OID:
+              case FLOAT4OID:
+              case FLOAT8OID:
+              case NUMERICOID: {
+                double number = 0;
+                if (helper::parse_number(value, number)) {
+                  return number;
+                }
+                break;
+              }
+              default:
+                break;
+            }
+          } else {
+            switch (type) {
+              case FLOAT4OID: {
+                binary::assert_length("float4", len, 4);
+                auto bits = binary::get_int32(value);
+                float f;
+                memcpy(&f, &bits, sizeof(f));
+                return f;
+              }
+              case FLOAT8OID: {
+                binary::assert_length("float8", len, 8);
+                auto bits = binary::get_int64(value);
+                double d;
+                memcpy(&d, &bits, sizeof(d));
+                return d;
+              }
+              case BOOLOID:
+              case CHAROID:
+              case INT2OID:
+              case INT4OID:
+              case INT8OID:
+                return static_cast<double>(to_int64(type, value, len, format));
+              default:
+                break;
+            }
+          }
+
+          auto result = to_value(type, value, len, format);
+
+          return result == sql_null ? 0 : result.as<double>();
+        }
+
+        string to_text(Oid type, const char *value, int len, int format) {
+          if (value == nullptr) {
+            return string();
+          }
+
+          if (format == 0 && type != BYTEAOID) {
+            return string(value, static_cast<size_t>(len));
+          }
+
+          switch (type) {
+            case VARCHAROID:
+            case TEXTOID:
+            case BPCHAROID:
+            case NAMEOID:
+              return string(value, static_cast<size_t>(len));
+            default:
+              break;
+          }
+
+          auto result = to_value(type, value, len, format);
+
+          return result == sql_null ? string() : result.as<string>();
+        }
+
         /**
          * a visitor to apply a number to a postgres binding
          */
@@ -80,103 +442,47 @@ namespace coda::db::postgres {
             wchar_t buf[10] = {0};
             swprintf(buf, 10, L"%c", value);
             string temp = helper::convert_string(buf);
-            bind_.values_[index_] = strdup(temp.c_str());
-            bind_.types_[index_] = INT2OID;
-            bind_.lengths_[index_] = sizeof(wchar_t);
-            bind_.formats_[index_] = 0;
+            bind_.set_data(index_, INT2OID, temp.data(), temp.size(), 0);
           }
           void operator()(unsigned char value) const {
             char buf[10] = {0};
             sprintf(buf, "%uc", value);
-            bind_.values_[index_] = strdup(buf);
-            bind_.types_[index_] = CHAROID;
-            bind_.lengths_[index_] = sizeof(unsigned char);
-            bind_.formats_[index_] = 0;
+            bind_.set_data(index_, CHAROID, buf, strlen(buf), 0);
           }
           void operator()(char value) const {
             char buf[10] = {0};
             sprintf(buf, "%c", value);
-            bind_.values_[index_] = strdup(buf);
-            bind_.types_[index_] = CHAROID;
-            bind_.lengths_[index_] = sizeof(char);
-            bind_.formats_[index_] = 0;
-          }
-          void operator()(bool value) const {
-            bind_.values_[index_] = strdup(std::to_string(value).c_str());
-            bind_.types_[index_] = BOOLOID;
-            bind_.lengths_[index_] = sizeof(double);
-            bind_.formats_[index_] = 0;
+            bind_.set_data(index_, CHAROID, buf, strlen(buf), 0);
           }
+          void operator()(bool value) const { bind_.set_binary(index_, BOOLOID, value ? 1 : 0, 1); }
           void operator()(double value) const {
-            bind_.values_[index_] = strdup(std::to_string(value).c_str());
-            bind_.types_[index_] = FLOAT4OID;
-            bind_.lengths_[index_] = sizeof(double);
-            bind_.formats_[index_] = 0;
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            bind_.set_binary(index_, FLOAT8OID, bits, sizeof(bits));
           }
           void operator()(float value) const {
-            bind_.values_[index_] = strdup(std::to_string(value).c_str());
-            bind_.types_[index_] = FLOAT4OID;
-            bind_.lengths_[index_] = sizeof(float);
-            bind_.formats_[index_] = 0;
-          }
-          void operator()(long double value) const {
-            bind_.values_[index_] = strdup(std::to_string(value).c_str());
-            bind_.types_[index_] = FLOAT8OID;
-            bind_.lengths_[index_] = sizeof(long double);
-            bind_.formats_[index_] = 0;
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            bind_.set_binary(index_, FLOAT4OID, bits, sizeof(bits));
           }
-          void operator()(unsigned long long value) const {
-            bind_.values_[index_] = strdup(std::to_string(value).c_str());
-            bind_.types_[index_] = INT8OID;
-            bind_.lengths_[index_] = sizeof(unsigned long long);
-            bind_.formats_[index_] = 0;
-          }
-
+          void operator()(long double value) const { operator()(static_cast<double>(value)); }
+          void operator()(unsigned long long value) const { bind_.set_binary(index_, INT8OID, value, 8); }
           void operator()(long long value) const {
-            bind_.values_[index_] = strdup(std::to_string(value).c_str());
-            bind_.types_[index_] = INT8OID;
-            bind_.lengths_[index_] = sizeof(long long);
-            bind_.formats_[index_] = 0;
+            bind_.set_binary(index_, INT8OID, static_cast<uint64_t>(value), 8);
           }
-
-          void operator()(unsigned int value) const {
-            bind_.values_[index_] = strdup(std::to_string(value).c_str());
-            bind_.types_[index_] = INT4OID;
-            bind_.lengths_[index_] = sizeof(unsigned);
-            bind_.formats_[index_] = 0;
-          }
-
+          // unsigned values are widened so they are not read back as negative
+          void operator()(unsigned int value) const { bind_.set_binary(index_, INT8OID, value, 8); }
           void operator()(int value) const {
-            bind_.values_[index_] = strdup(std::to_string(value).c_str());
-            bind_.types_[index_] = INT4OID;
-            bind_.lengths_[index_] = sizeof(int);
-            bind_.formats_[index_] = 0;
-          }
-          void operator()(unsigned long value) const {
-            bind_.values_[index_] = strdup(std::to_string(value).c_str());
-            bind_.types_[index_] = INT4OID;
-            bind_.lengths_[index_] = sizeof(unsigned long);
-            bind_.formats_[index_] = 0;
+            bind_.set_binary(index_, INT4OID, static_cast<uint32_t>(value), 4);
           }
-
+          void operator()(unsigned long value) const { bind_.set_binary(index_, INT8OID, value, 8); }
           void operator()(long value) const {
-            bind_.values_[index_] = strdup(std::to_string(value).c_str());
-            bind_.types_[index_] = INT4OID;
-            bind_.lengths_[index_] = sizeof(long);
-            bind_.formats_[index_] = 0;
+            bind_.set_binary(index_, INT8OID, static_cast<uint64_t>(value), 8);
           }
           void operator()(short value) const {
-            bind_.values_[index_] = strdup(std::to_string(value).c_str());
-            bind_.types_[index_] = INT2OID;
-            bind_.lengths_[index_] = sizeof(short);
-            bind_.formats_[index_] = 0;
-          }
-          void operator()(unsigned short value) const {
-            bind_.values_[index_] = strdup(std::to_string(value).c_str());
-            bind_.types_[index_] = INT2OID;
-            bind_.lengths_[index_] = sizeof(unsigned short);
-            bind_.formats_[index_] = 0;
+            bind_.set_binary(index_, INT2OID, static_cast<uint16_t>(value), 2);
           }
+          void operator()(unsigned short value) const { bind_.set_binary(index_, INT4OID, value, 4); }
           void operator()(const sql_null_type &value) const {
             bind_.values_[index_] = 0;
             bind_.types_[index_] = UNKNOWNOID;
@@ -196,21 +502,18 @@ namespace coda::db::postgres {
          public:
           from_value(binding &bind, size_t index) : bind_(bind), index_(index) {}
           void operator()(const sql_time &value) const {
-            bind_.values_[index_] = strdup(value.to_string().c_str());
             switch (value.format()) {
               case sql_time::DATE:
-                bind_.types_[index_] = DATEOID;
+                bind_.set_binary(index_, DATEOID, static_cast<uint32_t>(to_binary_date(value)), 4);
                 break;
               case sql_time::TIME:
-                bind_.types_[index_] = TIMEOID;
+                bind_.set_binary(index_, TIMEOID, static_cast<uint64_t>(to_binary_time(value)), 8);
                 break;
               case sql_time::DATETIME:
               case sql_time::TIMESTAMP:
-                bind_.types_[index_] = TIMESTAMPOID;
+                bind_.set_binary(index_, TIMESTAMPOID, static_cast<uint64_t>(to_binary_timestamp(value)), 8);
                 break;
             }
-            bind_.lengths_[index_] = sizeof(time_t);
-            bind_.formats_[index_] = 0;
           }
           void operator()(const sql_null_type &value) const {
             bind_.values_[index_] = nullptr;
@@ -219,23 +522,14 @@ namespace coda::db::postgres {
             bind_.formats_[index_] = 0;
           }
           void operator()(const sql_blob &value) const {
-            bind_.values_[index_] = static_cast<char *>(c_copy(value.get(), value.size()));
-            bind_.types_[index_] = BYTEAOID;
-            bind_.lengths_[index_] = static_cast<int>(value.size());
-            bind_.formats_[index_] = 1;
+            bind_.set_data(index_, BYTEAOID, value.get(), value.size(), 1);
           }
           void operator()(const sql_wstring &value) const {
             string temp = helper::convert_string(value);
-            bind_.values_[index_] = strdup(temp.c_str());
-            bind_.types_[index_] = TEXTOID;
-            bind_.lengths_[index_] = static_cast<int>(temp.size());
-            bind_.formats_[index_] = 0;
+            bind_.set_data(index_, TEXTOID, temp.data(), temp.size(), 0);
           }
           void operator()(const sql_string &value) const {
-            bind_.values_[index_] = strdup(value.c_str());
-            bind_.types_[index_] = TEXTOID;
-            bind_.lengths_[index_] = static_cast<int>(value.size());
-            bind_.formats_[index_] = 0;
+            bind_.set_data(index_, TEXTOID, value.data(), value.size(), 0);
           }
           void operator()(const sql_number &value) const { value.apply_visitor(from_number(bind_, index_)); }
 
@@ -248,11 +542,82 @@ namespace coda::db::postgres {
       binding::binding() : binding(prealloc_size) {}
 
       binding::binding(size_t size)
-          : values_(nullptr), types_(nullptr), lengths_(nullptr), formats_(nullptr), size_(size) {
+          : values_(nullptr),
+            types_(nullptr),
+            lengths_(nullptr),
+            formats_(nullptr),
+            data_(nullptr),
+            buffers_(nullptr),
+            buffer_sizes_(nullptr),
+            size_(size) {
         values_ = c_alloc<char *>(size);
         types_ = c_alloc<Oid>(size);
         lengths_ = c_alloc<int>(size);
         formats_ = c_alloc<int>(size);
+        data_ = c_alloc<uint64_t>(size);
+        buffers_ = c_alloc<char *>(size);
+        buffer_sizes_ = c_alloc<size_t>(size);
+      }
+
+      // fixed width values are stored in a reusable slot per parameter instead of being allocated
+      char *binding::data_slot(size_t index) const { return reinterpret_cast<char *>(&data_[index]); }
+
+      void binding::set_binary(size_t index, Oid type, uint64_t value, int size) {
+        auto slot = data_slot(index);
+
+        switch (size) {
+          case 1:
+            slot[0] = static_cast<char>(value);
+            break;
+          case 2: {
+            uint16_t n = htons(static_cast<uint16_t>(value));
+            memcpy(slot, &n, sizeof(n));
+            break;
+          }
+          case 4: {
+            uint32_t n = htonl(static_cast<uint32_t>(value));
+            memcpy(slot, &n, sizeof(n));
+            break;
+          }
+          default: {
+            uint32_t hi = htonl(static_cast<uint32_t>(value >> 32));
+            uint32_t lo = htonl(static_cast<uint32_t>(value & 0xFFFFFFFF));
+            memcpy(slot, &hi, sizeof(hi));
+            memcpy(slot + sizeof(hi), &lo, sizeof(lo));
+            break;
+          }
+        }
+
+        values_[index] = slot;
+        types_[index] = type;
+        lengths_[index] = size;
+        formats_[index] = 1;
+      }
+
+      // variable length values are copied into a buffer per parameter that only grows, so rebinding does not allocate
+      void binding::set_data(size_t index, Oid type, const void *data, size_t size, int format) {
+        // text values are read up to a terminator
+        if (buffer_sizes_[index] < size + 1) {
+          auto mem = realloc(buffers_[index], size + 1);
+
+          if (mem == nullptr) {
+            throw std::bad_alloc();
+          }
+
+          buffers_[index] = static_cast<char *>(mem);
+          buffer_sizes_[index] = size + 1;
+        }
+
+        if (size > 0) {
+          memcpy(buffers_[index], data, size);
+        }
+
+        buffers_[index][size] = '\0';
+
+        values_[index] = buffers_[index];
+        types_[index] = type;
+        lengths_[index] = static_cast<int>(size);
+        formats_[index] = format;
       }
 
       void binding::clear_value(size_t i) {
@@ -260,10 +625,8 @@ namespace coda::db::postgres {
           throw binding_error("invalid index in postgres binding clear");
         }
 
-        if (values_[i]) {
-          free(values_[i]);
-          values_[i] = nullptr;
-        }
+        // the buffer is kept for the next value
+        values_[i] = nullptr;
         types_[i] = 0;
         lengths_[i] = 0;
         formats_[i] = 0;
@@ -271,12 +634,20 @@ namespace coda::db::postgres {
 
       void binding::clear_value() {
         if (values_) {
-          for (size_t i = 0; i < size_; i++) {
-            clear_value(i);
-          }
           free(values_);
           values_ = nullptr;
         }
+        if (buffers_) {
+          for (size_t i = 0; i < size_; i++) {
+            free(buffers_[i]);
+          }
+          free(buffers_);
+          buffers_ = nullptr;
+        }
+        if (buffer_sizes_) {
+          free(buffer_sizes_);
+          buffer_sizes_ = nullptr;
+        }
         if (types_) {
           free(types_);
           types_ = nullptr;
@@ -289,6 +660,10 @@ namespace coda::db::postgres {
           free(formats_);
           formats_ = nullptr;
         }
+        if (data_) {
+          free(data_);
+          data_ = nullptr;
+        }
         size_ = 0;
       }
 
@@ -300,19 +675,36 @@ namespace coda::db::postgres {
         types_ = c_alloc<Oid>(size_);
         lengths_ = c_alloc<int>(size_);
         formats_ = c_alloc<int>(size_);
+        data_ = c_alloc<uint64_t>(size_);
+        buffers_ = c_alloc<char *>(size_);
+        buffer_sizes_ = c_alloc<size_t>(size_);
 
         for (size_t i = 0; i < size_; i++) {
           types_[i] = value.types_[i];
           lengths_[i] = value.lengths_[i];
           formats_[i] = value.formats_[i];
-          if (value.values_[i]) {
-            values_[i] = strdup(value.values_[i]);
+          data_[i] = value.data_[i];
+          if (value.values_[i] == nullptr) {
+            continue;
+          }
+          if (value.values_[i] == value.data_slot(i)) {
+            values_[i] = data_slot(i);
+          } else {
+            set_data(i, types_[i], value.values_[i], static_cast<size_t>(lengths_[i]), formats_[i]);
           }
         }
       }
 
       binding::binding(const binding &other)
-          : bind_mapping(other), values_(nullptr), types_(nullptr), lengths_(nullptr), formats_(nullptr), size_(0) {
+          : bind_mapping(other),
+            values_(nullptr),
+            types_(nullptr),
+            lengths_(nullptr),
+            formats_(nullptr),
+            data_(nullptr),
+            buffers_(nullptr),
+            buffer_sizes_(nullptr),
+            size_(0) {
         copy_value(other);
       }
       binding::binding(binding &&other) noexcept
@@ -321,11 +713,17 @@ namespace coda::db::postgres {
             types_(other.types_),
             lengths_(other.lengths_),
             formats_(other.formats_),
+            data_(other.data_),
+            buffers_(other.buffers_),
+            buffer_sizes_(other.buffer_sizes_),
             size_(other.size_) {
         other.values_ = nullptr;
         other.types_ = nullptr;
         other.lengths_ = nullptr;
         other.formats_ = nullptr;
+        other.data_ = nullptr;
+        other.buffers_ = nullptr;
+        other.buffer_sizes_ = nullptr;
         other.size_ = 0;
       }
 
@@ -342,11 +740,17 @@ namespace coda::db::postgres {
         types_ = other.types_;
         lengths_ = other.lengths_;
         formats_ = other.formats_;
+        data_ = other.data_;
+        buffers_ = other.buffers_;
+        buffer_sizes_ = other.buffer_sizes_;
         size_ = other.size_;
         other.values_ = nullptr;
         other.types_ = nullptr;
         other.lengths_ = nullptr;
         other.formats_ = nullptr;
+        other.data_ = nullptr;
+        other.buffers_ = nullptr;
+        other.buffer_sizes_ = nullptr;
         other.size_ = 0;
         return *this;
       }
@@ -356,7 +760,7 @@ namespace coda::db::postgres {
         if (index >= size_ || values_ == nullptr || values_[index] == nullptr) {
           return sql_null;
         }
-        return data_mapper::to_value(types_[index], values_[index], lengths_[index]);
+        return data_mapper::to_value(types_[index], values_[index], lengths_[index], formats_[index]);
       }
 
       int binding::sql_type(size_t index) const {
@@ -384,10 +788,26 @@ namespace coda::db::postgres {
           throw std::bad_alloc();
         }
 
+        // values stored in a slot must follow the slots when they move
+        std::vector<size_t> slotted;
+
+        for (size_t i = 0; i < size_; i++) {
+          if (values_[i] != nullptr && values_[i] == data_slot(i)) {
+            slotted.push_back(i);
+          }
+        }
+
         values_ = c_alloc<char *>(values_, index, size_);
         types_ = c_alloc<Oid>(types_, index, size_);
         lengths_ = c_alloc<int>(lengths_, index, size_);
         formats_ = c_alloc<int>(formats_, index, size_);
+        data_ = c_alloc<uint64_t>(data_, index, size_);
+        buffers_ = c_alloc<char *>(buffers_, index, size_);
+        buffer_sizes_ = c_alloc<size_t>(buffer_sizes_, index, size_);
+
+        for (auto i : slotted) {
+          values_[i] = data_slot(i);
+        }
 
         size_ = index;
 
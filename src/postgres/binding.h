@@ -6,17 +6,32 @@
 #define CODA_DB_POSTGRES_BINDING_H
 
 #include <libpq-fe.h>
+#include <cstdint>
 #include <string>
 #include "../bind_mapping.h"
 
 namespace coda::db {
   class sql_value;
+  class sql_time;
 
   namespace postgres {
     namespace data_mapper {
+      // seconds between the unix epoch and the postgres epoch (2000-01-01)
+      constexpr long long POSTGRES_EPOCH_OFFSET = 946684800LL;
+
       class from_number;
       class from_value;
       sql_value to_value(Oid type, const char *value, int len);
+      sql_value to_value(Oid type, const char *value, int len, int format);
+      long long to_int64(Oid type, const char *value, int len, int format);
+      double to_double(Oid type, const char *value, int len, int format);
+      std::string to_text(Oid type, const char *value, int len, int format);
+      /*! @return the days since the postgres epoch, rounded towards the earlier day */
+      int32_t to_binary_date(const sql_time &value);
+      /*! @return the microseconds since midnight */
+      int64_t to_binary_time(const sql_time &value);
+      /*! @return the microseconds since the postgres epoch */
+      int64_t to_binary_timestamp(const sql_time &value);
     }  // namespace data_mapper
     /*
      * utility class to simplify binding query parameters
@@ -32,8 +47,14 @@ namespace coda::db {
       Oid *types_;
       int *lengths_;
       int *formats_;
+      uint64_t *data_;
+      char **buffers_;
+      size_t *buffer_sizes_;
       size_t size_;
       void copy_value(const binding &other);
+      char *data_slot(size_t index) const;
+      void set_binary(size_t index, Oid type, uint64_t value, int size);
+      void set_data(size_t index, Oid type, const void *data, size_t size, int format);
       void clear_value();
       void clear_value(size_t index);
       bool reallocate_value(size_t index);
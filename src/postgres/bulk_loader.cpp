@@ -0,0 +1,507 @@
+
+#include "bulk_loader.h"
+#include <arpa/inet.h>
+#include <poll.h>
+#include <cstring>
+#include <libpq-fe.h>
+#include <postgres.h>
+
+#include <catalog/pg_type.h>
+
+#include "../exception.h"
+#include "../number_format.h"
+#include "../sql_time.h"
+#include "binding.h"
+#include "session.h"
+
+using namespace std;
+
+namespace coda::db::postgres {
+      namespace helper {
+        const char BINARY_SIGNATURE[] = "PGCOPY\n\377\r\n";
+
+        void put_int16(std::string &buf, int16_t value) {
+          uint16_t n = htons(static_cast<uint16_t>(value));
+          buf.append(reinterpret_cast<const char *>(&n), sizeof(n));
+        }
+
+        void put_int32(std::string &buf, int32_t value) {
+          uint32_t n = htonl(static_cast<uint32_t>(value));
+          buf.append(reinterpret_cast<const char *>(&n), sizeof(n));
+        }
+
+        void put_int64(std::string &buf, int64_t value) {
+          put_int32(buf, static_cast<int32_t>(static_cast<uint64_t>(value) >> 32));
+          put_int32(buf, static_cast<int32_t>(static_cast<uint64_t>(value) & 0xFFFFFFFF));
+        }
+
+        /*!
+         * appends a field with its length prefix
+         */
+        void put_field(std::string &buf, const void *data, size_t size) {
+          put_int32(buf, static_cast<int32_t>(size));
+          buf.append(static_cast<const char *>(data), size);
+        }
+
+        /*!
+         * appends a value escaped for the text COPY format
+         */
+        void put_escaped(std::string &buf, const std::string &value) {
+          for (auto c : value) {
+            switch (c) {
+              case '\\':
+                buf += "\\\\";
+                break;
+              case '\n':
+                buf += "\\n";
+                break;
+              case '\r':
+                buf += "\\r";
+                break;
+              case '\t':
+                buf += "\\t";
+                break;
+              default:
+                buf += c;
+                break;
+            }
+          }
+        }
+
+        bool is_binary_supported(Oid type) {
+          switch (type) {
+            case BOOLOID:
+            case INT2OID:
+            case INT4OID:
+            case INT8OID:
+            case FLOAT4OID:
+            case FLOAT8OID:
+            case TEXTOID:
+            case VARCHAROID:
+            case BPCHAROID:
+            case NAMEOID:
+            case BYTEAOID:
+            case DATEOID:
+            case TIMESTAMPOID:
+            case TIMESTAMPTZOID:
+              return true;
+            default:
+              return false;
+          }
+        }
+      }  // namespace helper
+
+      bulk_loader::bulk_loader(const std::shared_ptr<postgres::session> &sess, const std::string &tableName,
+                               const std::vector<std::string> &columns, format_type format, size_t bufferSize)
+          : sess_(sess),
+            tableName_(tableName),
+            columns_(columns),
+            format_(format),
+            bufferSize_(bufferSize),
+            rows_(0),
+            active_(false) {
+        if (sess_ == nullptr) {
+          throw database_exception("no database provided to postgres bulk loader");
+        }
+
+        if (tableName_.empty() || columns_.empty()) {
+          throw database_exception("postgres bulk loader requires a table and columns");
+        }
+
+        buffer_.reserve(bufferSize_);
+      }
+
+      bulk_loader::bulk_loader(bulk_loader &&other) noexcept
+          : sess_(std::move(other.sess_)),
+            tableName_(std::move(other.tableName_)),
+            columns_(std::move(other.columns_)),
+            types_(std::move(other.types_)),
+            format_(other.format_),
+            bufferSize_(other.bufferSize_),
+            buffer_(std::move(other.buffer_)),
+            rows_(other.rows_),
+            active_(other.active_) {
+        other.sess_ = nullptr;
+        other.active_ = false;
+      }
+
+      bulk_loader &bulk_loader::operator=(bulk_loader &&other) noexcept {
+        if (this == &other) {
+          return *this;
+        }
+
+        // the connection would otherwise be left in the middle of a copy
+        if (sess_ != nullptr && active_) {
+          try {
+            abort("bulk load was replaced");
+          } catch (...) {
+          }
+        }
+
+        sess_ = std::move(other.sess_);
+        tableName_ = std::move(other.tableName_);
+        columns_ = std::move(other.columns_);
+        types_ = std::move(other.types_);
+        format_ = other.format_;
+        bufferSize_ = other.bufferSize_;
+        buffer_ = std::move(other.buffer_);
+        rows_ = other.rows_;
+        active_ = other.active_;
+
+        other.sess_ = nullptr;
+        other.active_ = false;
+
+        return *this;
+      }
+
+      bulk_loader::~bulk_loader() {
+        if (sess_ == nullptr || !active_) {
+          return;
+        }
+        try {
+          abort("bulk load was not finished");
+        } catch (...) {
+        }
+      }
+
+      bool bulk_loader::is_active() const noexcept { return active_; }
+
+      size_t bulk_loader::num_of_rows() const noexcept { return rows_; }
+
+      void bulk_loader::start() {
+        if (active_) {
+          return;
+        }
+
+        if (!sess_->is_open()) {
+          throw database_exception("postgres database not open");
+        }
+
+        auto db = sess_->db_.get();
+
+        string columns;
+
+        for (size_t i = 0; i < columns_.size(); i++) {
+          if (i > 0) {
+            columns += ",";
+          }
+          columns += columns_[i];
+        }
+
+        if (format_ == BINARY) {
+          // binary values must match the column types exactly
+          PGresult *res = PQexec(db, ("SELECT " + columns + " FROM " + tableName_ + " LIMIT 0").c_str());
+
+          if (PQresultStatus(res) != PGRES_TUPLES_OK) {
+            PQclear(res);
+            throw database_exception(sess_->last_error());
+          }
+
+          types_.clear();
+
+          for (int i = 0; i < PQnfields(res); i++) {
+            types_.push_back(PQftype(res, i));
+
+            if (!helper::is_binary_supported(types_.back())) {
+              PQclear(res);
+              throw database_exception("unsupported column type for binary copy: " + columns_[i]);
+            }
+          }
+
+          PQclear(res);
+        }
+
+        string sql = "COPY " + tableName_ + "(" + columns + ") FROM STDIN";
+
+        if (format_ == BINARY) {
+          sql += " WITH (FORMAT binary)";
+        }
+
+        PGresult *res = PQexec(db, sql.c_str());
+
+        if (PQresultStatus(res) != PGRES_COPY_IN) {
+          PQclear(res);
+          throw database_exception(sess_->last_error());
+        }
+
+        PQclear(res);
+
+        active_ = true;
+        rows_ = 0;
+        buffer_.clear();
+
+        if (format_ == BINARY) {
+          buffer_.append(helper::BINARY_SIGNATURE, sizeof(helper::BINARY_SIGNATURE));
+          // flags and header extension length
+          helper::put_int32(buffer_, 0);
+          helper::put_int32(buffer_, 0);
+        }
+      }
+
+      bulk_loader &bulk_loader::add_row(const std::vector<sql_value> &row) {
+        if (row.size() != columns_.size()) {
+          throw binding_error("bulk load row " + std::to_string(rows_ + 1) +
+                              " does not match the number of columns");
+        }
+
+        start();
+
+        auto size = buffer_.size();
+
+        try {
+          if (format_ == BINARY) {
+            encode_binary(row);
+          } else {
+            encode_text(row);
+          }
+        } catch (const std::exception &e) {
+          // drop the partial row so the copy can continue
+          buffer_.resize(size);
+          throw binding_error("bulk load row " + std::to_string(rows_ + 1) + ": " + e.what());
+        }
+
+        rows_++;
+
+        if (buffer_.size() >= bufferSize_) {
+          flush();
+        }
+
+        return *this;
+      }
+
+      void bulk_loader::encode_text(const std::vector<sql_value> &row) {
+        for (size_t i = 0; i < row.size(); i++) {
+          if (i > 0) {
+            buffer_ += '\t';
+          }
+
+          const auto &value = row[i];
+
+          if (value == sql_null) {
+            buffer_ += "\\N";
+          } else if (value.is<sql_blob>()) {
+            auto blob = value.as<sql_blob>();
+            auto data = static_cast<const unsigned char *>(blob.get());
+            static const char hex[] = "0123456789abcdef";
+
+            // bytea hex format, with the backslash escaped for COPY
+            buffer_ += "\\\\x";
+            for (size_t j = 0; j < blob.size(); j++) {
+              buffer_ += hex[data[j] >> 4];
+              buffer_ += hex[data[j] & 0x0F];
+            }
+          } else {
+            helper::put_escaped(buffer_, value.to_string());
+          }
+        }
+        buffer_ += '\n';
+      }
+
+      void bulk_loader::encode_binary(const std::vector<sql_value> &row) {
+        helper::put_int16(buffer_, static_cast<int16_t>(row.size()));
+
+        for (size_t i = 0; i < row.size(); i++) {
+          const auto &value = row[i];
+
+          if (value == sql_null) {
+            helper::put_int32(buffer_, -1);
+            continue;
+          }
+
+          switch (types_[i]) {
+            case BOOLOID: {
+              char b = value.as<bool>() ? 1 : 0;
+              helper::put_field(buffer_, &b, sizeof(b));
+              break;
+            }
+            case INT2OID:
+              helper::put_int32(buffer_, 2);
+              helper::put_int16(buffer_, value.as<short>());
+              break;
+            case INT4OID:
+              helper::put_int32(buffer_, 4);
+              helper::put_int32(buffer_, value.as<int>());
+              break;
+            case INT8OID:
+              helper::put_int32(buffer_, 8);
+              helper::put_int64(buffer_, value.as<long long>());
+              break;
+            case FLOAT4OID: {
+              float f = value.as<float>();
+              int32_t bits;
+              memcpy(&bits, &f, sizeof(bits));
+              helper::put_int32(buffer_, 4);
+              helper::put_int32(buffer_, bits);
+              break;
+            }
+            case FLOAT8OID: {
+              double d = value.as<double>();
+              int64_t bits;
+              memcpy(&bits, &d, sizeof(bits));
+              helper::put_int32(buffer_, 8);
+              helper::put_int64(buffer_, bits);
+              break;
+            }
+            case BYTEAOID: {
+              auto blob = value.as<sql_blob>();
+              helper::put_field(buffer_, blob.get(), blob.size());
+              break;
+            }
+            case DATEOID:
+              helper::put_int32(buffer_, 4);
+              helper::put_int32(buffer_, data_mapper::to_binary_date(value.as<sql_time>()));
+              break;
+            case TIMESTAMPOID:
+            case TIMESTAMPTZOID:
+              helper::put_int32(buffer_, 8);
+              helper::put_int64(buffer_, data_mapper::to_binary_timestamp(value.as<sql_time>()));
+              break;
+            default: {
+              // text types
+              auto text = value.to_string();
+              helper::put_field(buffer_, text.data(), text.size());
+              break;
+            }
+          }
+        }
+      }
+
+      void bulk_loader::wait_for_socket() {
+        pollfd fd = {};
+        fd.fd = PQsocket(sess_->db_.get());
+        fd.events = POLLOUT;
+        poll(&fd, 1, -1);
+      }
+
+      void bulk_loader::throw_result_error(PGresult *failed) {
+        auto db = sess_->db_.get();
+
+        string message = sess_->last_error();
+        string context;
+        bool found = false;
+
+        // the failed result is read first, then the rest are drained
+        PGresult *res = failed != nullptr ? failed : PQgetResult(db);
+
+        for (; res != nullptr; res = PQgetResult(db)) {
+          if (!found && PQresultStatus(res) == PGRES_FATAL_ERROR) {
+            found = true;
+
+            auto primary = PQresultErrorField(res, PG_DIAG_MESSAGE_PRIMARY);
+            auto where = PQresultErrorField(res, PG_DIAG_CONTEXT);
+
+            if (primary != nullptr) {
+              message = primary;
+            }
+            // ex. "COPY users, line 3, column dval: "abc""
+            if (where != nullptr) {
+              context = where;
+            }
+          }
+          PQclear(res);
+        }
+
+        active_ = false;
+        buffer_.clear();
+
+        throw database_exception(message, context);
+      }
+
+      void bulk_loader::put_data(const char *data, size_t size) {
+        int rc;
+
+        // in non-blocking mode zero means the send queue is full
+        while ((rc = PQputCopyData(sess_->db_.get(), data, static_cast<int>(size))) == 0) {
+          wait_for_socket();
+        }
+
+        if (rc < 0) {
+          // the server stopped the copy, usually because of a bad row
+          throw_result_error();
+        }
+      }
+
+      void bulk_loader::flush() {
+        if (!active_ || buffer_.empty()) {
+          return;
+        }
+
+        put_data(buffer_.data(), buffer_.size());
+
+        buffer_.clear();
+      }
+
+      sql_changes bulk_loader::finish() {
+        if (!active_) {
+          return 0;
+        }
+
+        if (format_ == BINARY) {
+          // file trailer
+          helper::put_int16(buffer_, -1);
+        }
+
+        flush();
+
+        auto db = sess_->db_.get();
+
+        int rc;
+
+        while ((rc = PQputCopyEnd(db, nullptr)) == 0) {
+          wait_for_socket();
+        }
+
+        if (rc < 0) {
+          throw_result_error();
+        }
+
+        PGresult *res = PQgetResult(db);
+
+        if (PQresultStatus(res) != PGRES_COMMAND_OK) {
+          throw_result_error(res);
+        }
+
+        sql_changes value = 0;
+
+        auto changes = PQcmdTuples(res);
+
+        if (changes != nullptr && !db::helper::parse_number(changes, value)) {
+          value = 0;
+        }
+
+        PQclear(res);
+
+        // drain the remaining results
+        while ((res = PQgetResult(db)) != nullptr) {
+          PQclear(res);
+        }
+
+        active_ = false;
+
+        sess_->set_last_number_of_changes(value);
+
+        return value;
+      }
+
+      void bulk_loader::abort(const std::string &reason) {
+        if (!active_) {
+          return;
+        }
+
+        auto db = sess_->db_.get();
+
+        buffer_.clear();
+
+        active_ = false;
+
+        while (PQputCopyEnd(db, reason.c_str()) == 0) {
+          wait_for_socket();
+        }
+
+        PGresult *res;
+
+        while ((res = PQgetResult(db)) != nullptr) {
+          PQclear(res);
+        }
+      }
+}  // namespace coda::db::postgres
@@ -0,0 +1,143 @@
+/*!
+ * @file bulk_loader.h
+ * loads rows into a postgres table using COPY
+ */
+#ifndef CODA_DB_POSTGRES_BULK_LOADER_H
+#define CODA_DB_POSTGRES_BULK_LOADER_H
+
+#include <libpq-fe.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../sql_types.h"
+#include "../sql_value.h"
+
+namespace coda::db::postgres {
+      class session;
+
+      /*!
+       * streams rows to a table with COPY ... FROM STDIN.
+       * rows are encoded into a buffer that is sent when full, and the
+       * connection blocks while the server catches up.
+       *
+       * ex. bulk_loader loader(session->impl<postgres::session>(), "users", {"first_name", "last_name"});
+       *     loader.add_row("Bryan", "Jenkins");
+       *     loader.finish();
+       */
+      class bulk_loader {
+       public:
+        /*!
+         * the COPY data format
+         */
+        typedef enum { TEXT, BINARY } format_type;
+
+        /*!
+         * the default size of the send buffer
+         */
+        static const size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+        /*!
+         * @param sess        the postgres session
+         * @param tableName   the table to load
+         * @param columns     the columns for each row
+         * @param format      the data format
+         * @param bufferSize  the amount of data to buffer before sending
+         */
+        bulk_loader(const std::shared_ptr<postgres::session> &sess, const std::string &tableName,
+                    const std::vector<std::string> &columns, format_type format = TEXT,
+                    size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+        /* non-copyable boilerplate */
+        bulk_loader(const bulk_loader &other) = delete;
+        bulk_loader &operator=(const bulk_loader &other) = delete;
+
+        /*!
+         * @param other the loader being moved, which is left inactive
+         */
+        bulk_loader(bulk_loader &&other) noexcept;
+
+        /*!
+         * aborts any copy in progress on this loader before taking over the other
+         * @param other the loader being moved, which is left inactive
+         */
+        bulk_loader &operator=(bulk_loader &&other) noexcept;
+
+        /*!
+         * aborts the copy if it was not finished
+         */
+        ~bulk_loader();
+
+        /*!
+         * starts the copy. called by the first add_row if needed.
+         * @throws database_exception if the copy could not be started
+         */
+        void start();
+
+        /*!
+         * adds a row to the copy
+         * @param value the value for the first column
+         * @param argv a variadic list of values for the remaining columns
+         * @return a reference to this instance
+         */
+        template<typename T, typename... List>
+        bulk_loader &add_row(const T &value, const List &... argv) {
+          return add_row(std::vector<sql_value>{sql_value(value), sql_value(argv)...});
+        }
+
+        /*!
+         * adds a row to the copy
+         * @param row the values, one for each column
+         * @return a reference to this instance
+         * @throws binding_error if the row can not be encoded
+         * @throws database_exception if the server rejected the copy
+         */
+        bulk_loader &add_row(const std::vector<sql_value> &row);
+
+        /*!
+         * sends any buffered rows
+         */
+        void flush();
+
+        /*!
+         * ends the copy and waits for the server
+         * @return the number of rows loaded
+         * @throws database_exception with the failing line as context if the server rejected a row
+         */
+        sql_changes finish();
+
+        /*!
+         * cancels the copy, no rows are loaded
+         * @param reason the reason reported to the server
+         */
+        void abort(const std::string &reason = "bulk load aborted");
+
+        /*!
+         * @return true if a copy is in progress
+         */
+        bool is_active() const noexcept;
+
+        /*!
+         * @return the number of rows added
+         */
+        size_t num_of_rows() const noexcept;
+
+       private:
+        void encode_text(const std::vector<sql_value> &row);
+        void encode_binary(const std::vector<sql_value> &row);
+        void put_data(const char *data, size_t size);
+        void wait_for_socket();
+        void throw_result_error(PGresult *failed = nullptr);
+
+        std::shared_ptr<postgres::session> sess_;
+        std::string tableName_;
+        std::vector<std::string> columns_;
+        std::vector<Oid> types_;
+        format_type format_;
+        size_t bufferSize_;
+        std::string buffer_;
+        size_t rows_;
+        bool active_;
+      };
+}  // namespace coda::db::postgres
+
+#endif
@@ -15,8 +15,12 @@ namespace coda::db::postgres {
           throw no_such_column_exception();
         }
 
+        if (PQgetisnull(stmt_.get(), row_, column_)) {
+          return sql_null;
+        }
+
         return data_mapper::to_value(PQftype(stmt_.get(), column_), PQgetvalue(stmt_.get(), row_, column_),
-                                     PQgetlength(stmt_.get(), row_, column_));
+                                     PQgetlength(stmt_.get(), row_, column_), PQfformat(stmt_.get(), column_));
       }
 
       int column::sql_type() const {
@@ -26,6 +30,19 @@ namespace coda::db::postgres {
         return PQftype(stmt_.get(), column_);
       }
 
+      string_view column::to_view() const {
+        if (!is_valid()) {
+          throw no_such_column_exception();
+        }
+
+        if (PQgetisnull(stmt_.get(), row_, column_)) {
+          return string_view();
+        }
+
+        return string_view(PQgetvalue(stmt_.get(), row_, column_),
+                           static_cast<size_t>(PQgetlength(stmt_.get(), row_, column_)));
+      }
+
       string column::name() const {
         if (!is_valid()) {
           return string();
@@ -38,6 +38,11 @@ namespace coda::db::postgres {
     sql_value to_value() const override;
     int sql_type() const;
     std::string name() const override;
+
+    /*!
+     * @return a view of the value as sent by the server, in text or binary format
+     */
+    std::string_view to_view() const override;
   };
 }  // namespace coda::db::postgres
 
@@ -1,5 +1,8 @@
 #include "resultset.h"
+#include <postgres.h>
+#include <catalog/pg_type.h>
 #include "../exception.h"
+#include "binding.h"
 #include "row.h"
 #include "session.h"
 
@@ -29,5 +32,148 @@ namespace coda::db::postgres {
 
       void resultset::reset() { currentRow_ = -1; }
 
-      resultset::row_type resultset::current_row() { return row_type(make_shared<row>(sess_, stmt_, currentRow_)); }
+      resultset::row_type resultset::current_row() { return row_type(make_shared<row>(sess_, stmt_, currentRow_, columns())); }
+
+      size_t resultset::column_count() { return is_valid() ? PQnfields(stmt_.get()) : 0; }
+
+      size_t resultset::row_count() { return is_valid() ? PQntuples(stmt_.get()) : 0; }
+
+      sql_value resultset::column_value(size_t index) {
+        if (index >= column_count() || currentRow_ < 0) {
+          throw no_such_column_exception();
+        }
+
+        auto res = stmt_.get();
+        auto column = static_cast<int>(index);
+
+        if (PQgetisnull(res, currentRow_, column)) {
+          return sql_null;
+        }
+
+        return data_mapper::to_value(PQftype(res, column), PQgetvalue(res, currentRow_, column),
+                                     PQgetlength(res, currentRow_, column), PQfformat(res, column));
+      }
+
+      bool resultset::column_is_null(size_t index) {
+        if (index >= column_count() || currentRow_ < 0) {
+          throw no_such_column_exception();
+        }
+        return PQgetisnull(stmt_.get(), currentRow_, static_cast<int>(index));
+      }
+
+      long long resultset::column_int64(size_t index) {
+        if (column_is_null(index)) {
+          return 0;
+        }
+
+        auto res = stmt_.get();
+        auto column = static_cast<int>(index);
+
+        return data_mapper::to_int64(PQftype(res, column), PQgetvalue(res, currentRow_, column),
+                                     PQgetlength(res, currentRow_, column), PQfformat(res, column));
+      }
+
+      double resultset::column_double(size_t index) {
+        if (column_is_null(index)) {
+          return 0;
+        }
+
+        auto res = stmt_.get();
+        auto column = static_cast<int>(index);
+
+        return data_mapper::to_double(PQftype(res, column), PQgetvalue(res, currentRow_, column),
+                                      PQgetlength(res, currentRow_, column), PQfformat(res, column));
+      }
+
+      string resultset::column_text(size_t index) {
+        if (column_is_null(index)) {
+          return string();
+        }
+
+        auto res = stmt_.get();
+        auto column = static_cast<int>(index);
+
+        return data_mapper::to_text(PQftype(res, column), PQgetvalue(res, currentRow_, column),
+                                    PQgetlength(res, currentRow_, column), PQfformat(res, column));
+      }
+
+      string_view resultset::column_data(size_t index) {
+        if (column_is_null(index)) {
+          return string_view();
+        }
+
+        auto column = static_cast<int>(index);
+
+        return string_view(PQgetvalue(stmt_.get(), currentRow_, column),
+                           static_cast<size_t>(PQgetlength(stmt_.get(), currentRow_, column)));
+      }
+
+      batch_column::type resultset::batch_type(size_t index) {
+        if (index >= column_count()) {
+          throw no_such_column_exception();
+        }
+
+        switch (PQftype(stmt_.get(), static_cast<int>(index))) {
+          case BOOLOID:
+          case INT2OID:
+          case INT4OID:
+          case INT8OID:
+            return batch_column::integer;
+          case FLOAT4OID:
+          case FLOAT8OID:
+            return batch_column::real;
+          case BYTEAOID:
+            return batch_column::blob;
+          default:
+            return batch_column::text;
+        }
+      }
+
+      void resultset::append_batch(column_batch &batch) {
+        auto res = stmt_.get();
+
+        for (size_t i = 0; i < batch.column_count(); i++) {
+          auto &column = batch.column(i);
+          auto index = static_cast<int>(i);
+
+          if (PQgetisnull(res, currentRow_, index)) {
+            column.append_null();
+            continue;
+          }
+
+          auto type = PQftype(res, index);
+          auto value = PQgetvalue(res, currentRow_, index);
+          auto len = PQgetlength(res, currentRow_, index);
+          auto format = PQfformat(res, index);
+
+          switch (column.kind()) {
+            case batch_column::integer:
+              column.append(data_mapper::to_int64(type, value, len, format));
+              break;
+            case batch_column::real:
+              column.append(data_mapper::to_double(type, value, len, format));
+              break;
+            case batch_column::text:
+              if (format == 0 || type == TEXTOID || type == VARCHAROID || type == BPCHAROID || type == NAMEOID) {
+                column.append(value, static_cast<size_t>(len));
+              } else {
+                auto text = data_mapper::to_text(type, value, len, format);
+                column.append(text.data(), text.size());
+              }
+              break;
+            case batch_column::blob: {
+              auto blob = data_mapper::to_value(type, value, len, format).as<sql_blob>();
+              column.append(static_cast<const char *>(blob.get()), blob.size());
+              break;
+            }
+          }
+        }
+      }
+
+      string resultset::column_name(size_t index) {
+        if (index >= column_count()) {
+          throw no_such_column_exception();
+        }
+        return PQfname(stmt_.get(), static_cast<int>(index));
+      }
 }  // namespace coda::db::postgres
@@ -41,6 +41,17 @@ namespace coda::db::postgres {
         row_type current_row() override;
         void reset() override;
         bool next() override;
+        size_t column_count() override;
+        sql_value column_value(size_t index) override;
+        std::string column_name(size_t index) override;
+        bool column_is_null(size_t index) override;
+        long long column_int64(size_t index) override;
+        double column_double(size_t index) override;
+        std::string column_text(size_t index) override;
+        std::string_view column_data(size_t index) override;
+        batch_column::type batch_type(size_t index) override;
+        void append_batch(column_batch &batch) override;
+        size_t row_count() override;
       };
 }  // namespace coda::db::postgres
 
@@ -5,8 +5,9 @@
 using namespace std;
 
 namespace coda::db::postgres {
-  row::row(const std::shared_ptr<postgres::session> &sess, const shared_ptr<PGresult> &stmt, int row)
-      : row_impl(), stmt_(stmt), sess_(sess), row_(row) {
+  row::row(const std::shared_ptr<postgres::session> &sess, const shared_ptr<PGresult> &stmt, int row,
+           const shared_ptr<column_index> &columns)
+      : row_impl(), stmt_(stmt), sess_(sess), columns_(columns), row_(row) {
     if (sess_ == nullptr) {
       throw database_exception("no database provided to postgres row");
     }
@@ -31,6 +32,16 @@ namespace coda::db::postgres {
       throw no_such_column_exception();
     }
 
+    if (columns_ != nullptr) {
+      auto index = columns_->find(name);
+
+      if (index == column_index::npos) {
+        throw no_such_column_exception(name);
+      }
+
+      return column(index);
+    }
+
     for (size_t i = 0; i < size_; i++) {
       const char *col_name = PQfname(stmt_.get(), i);
 
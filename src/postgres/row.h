@@ -7,6 +7,7 @@
 
 #include <libpq-fe.h>
 #include <vector>
+#include "../column_index.h"
 #include "../row.h"
 
 namespace coda::db::postgres {
@@ -19,6 +20,7 @@ namespace coda::db::postgres {
    private:
     std::shared_ptr<PGresult> stmt_;
     std::shared_ptr<postgres::session> sess_;
+    std::shared_ptr<column_index> columns_;
     size_t size_;
     int row_;
 
@@ -27,8 +29,10 @@ namespace coda::db::postgres {
      * @param db    the database in use
      * @param stmt  the query statement result in use
      * @param row   the row index
+     * @param columns the shared column name index, if any
      */
-    row(const std::shared_ptr<postgres::session> &sess, const std::shared_ptr<PGresult> &stmt, int row);
+    row(const std::shared_ptr<postgres::session> &sess, const std::shared_ptr<PGresult> &stmt, int row,
+        const std::shared_ptr<column_index> &columns = nullptr);
 
     /* non-copyable boilerplate */
     ~row() override = default;
@@ -27,7 +27,7 @@ namespace coda::db::postgres {
 
       std::shared_ptr<coda::db::session_impl> factory::create(const uri &uri) { return std::make_shared<session>(uri); }
 
-      session::session(const uri &info) : session_impl(info), db_(nullptr), lastId_(0), lastNumChanges_(0) {}
+      session::session(const uri &info) : session_impl(info), db_(nullptr), lastId_(0), lastNumChanges_(0), lastStatementId_(0), binaryResults_(false) {}
 
       session::~session() {
         if (is_open()) {
@@ -75,6 +75,12 @@ namespace coda::db::postgres {
 
       void session::set_last_number_of_changes(unsigned long long value) { lastNumChanges_ = value; }
 
+      bool session::binary_results() const noexcept { return binaryResults_; }
+
+      void session::set_binary_results(bool value) noexcept { binaryResults_ = value; }
+
+      std::string session::next_statement_name() { return "coda_stmt_" + std::to_string(++lastStatementId_); }
+
       std::shared_ptr<resultset_impl> session::query(const string &sql) {
         if (db_ == nullptr) {
           throw database_exception("database is not open");
@@ -178,6 +184,20 @@ namespace coda::db::postgres {
       std::string session::bind_param(size_t index) const { return "$" + std::to_string(index); }
 
       constexpr int session::features() const {
-        return db::session::FEATURE_FULL_OUTER_JOIN | db::session::FEATURE_RETURNING | db::session::FEATURE_RIGHT_JOIN;
+        return db::session::FEATURE_FULL_OUTER_JOIN | db::session::FEATURE_RETURNING | db::session::FEATURE_RIGHT_JOIN |
+               db::session::FEATURE_ON_CONFLICT;
+      }
+
+      // the protocol uses a 16 bit parameter count
+      size_t session::max_bind_params() const { return 65535; }
+
+      bool session::in_transaction() const noexcept {
+        if (db_ == nullptr) {
+          return false;
+        }
+
+        auto status = PQtransactionStatus(db_.get());
+
+        return status == PQTRANS_ACTIVE || status == PQTRANS_INTRANS || status == PQTRANS_INERROR;
       }
 }  // namespace coda::db::postgres
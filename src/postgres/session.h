@@ -24,6 +24,7 @@ namespace coda::db::postgres {
       class session : public coda::db::session_impl, public std::enable_shared_from_this<session> {
         friend class statement;
         friend class factory;
+        friend class bulk_loader;
 
        protected:
         std::shared_ptr<PGconn> db_;
@@ -56,12 +57,33 @@ namespace coda::db::postgres {
         std::vector<column_definition> get_columns_for_schema(const std::string &dbName, const std::string &tablename) override;
         std::string bind_param(size_t index) const override;
         [[nodiscard]] constexpr int features() const override;
+        size_t max_bind_params() const override;
+        bool in_transaction() const noexcept override;
+
+        /*!
+         * @return true if statements request results in the binary format
+         */
+        bool binary_results() const noexcept;
+
+        /*!
+         * opts in to binary results, which are decoded without parsing text.
+         * types without a binary decoder are returned as blobs.
+         * @param value true to request binary results
+         */
+        void set_binary_results(bool value) noexcept;
 
        private:
         long long lastId_;
         unsigned long long lastNumChanges_;
+        unsigned long long lastStatementId_;
+        bool binaryResults_;
         void set_last_insert_id(long long value);
         void set_last_number_of_changes(unsigned long long value);
+
+        /*!
+         * @return a unique name for a server side prepared statement
+         */
+        std::string next_statement_name();
       };
 }  // namespace coda::db::postgres
 
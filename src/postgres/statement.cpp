@@ -1,7 +1,10 @@
 
 #include "statement.h"
 #include <algorithm>
+#include <postgres.h>
+#include <catalog/pg_type.h>
 #include "../exception.h"
+#include "../number_format.h"
 #include "resultset.h"
 #include "session.h"
 
@@ -21,16 +24,78 @@ namespace coda::db::postgres {
         }
       }
 
+      statement::~statement() { deallocate(); }
+
       void statement::prepare(const string &sql) {
         if (!sess_ || !sess_->is_open()) {
           throw database_exception("postgres database not open");
         }
 
+        deallocate();
+
         sql_ = bindings_.prepare(sql);
       }
 
+      void statement::prepare_on_server() {
+        auto count = bindings_.num_of_bindings();
+
+        // the server statement only lives as long as the connection it was prepared on
+        bool valid = !name_.empty() && conn_.lock() == sess_->db_ && types_.size() == count;
+
+        // parameter types are fixed on prepare. nulls are compatible with any type, and
+        // text values can be parsed as an inferred type, but binary values must match exactly
+        for (size_t i = 0; valid && i < count; i++) {
+          auto type = bindings_.types_[i];
+
+          valid = type == types_[i] || type == UNKNOWNOID ||
+                  (types_[i] == UNKNOWNOID && bindings_.formats_[i] == 0);
+        }
+
+        if (valid) {
+          return;
+        }
+
+        deallocate();
+
+        auto name = sess_->next_statement_name();
+
+        PGresult *res = PQprepare(sess_->db_.get(), name.c_str(), sql_.c_str(), static_cast<int>(count),
+                                  bindings_.types_);
+
+        if (PQresultStatus(res) != PGRES_COMMAND_OK) {
+          PQclear(res);
+          throw database_exception(last_error());
+        }
+
+        PQclear(res);
+
+        name_ = name;
+        conn_ = sess_->db_;
+        types_.assign(bindings_.types_, bindings_.types_ + count);
+      }
+
+      void statement::deallocate() noexcept {
+        if (name_.empty()) {
+          return;
+        }
+
+        auto conn = conn_.lock();
+
+        // a closed connection has already released its statements
+        if (conn != nullptr && sess_ != nullptr && conn == sess_->db_) {
+          PQclear(PQexec(conn.get(), ("DEALLOCATE " + name_).c_str()));
+        }
+
+        name_.clear();
+        conn_.reset();
+        types_.clear();
+      }
+
       bool statement::is_valid() const noexcept { return !sql_.empty(); }
 
+      // results are copied into their own PGresult
+      bool statement::is_busy() const noexcept { return false; }
+
       unsigned long long statement::last_number_of_changes() {
         if (stmt_ == nullptr) {
           return 0;
@@ -39,12 +104,8 @@ namespace coda::db::postgres {
 
         unsigned long long value = 0;
 
-        if (changes != nullptr && *changes != 0) {
-          try {
-            value = static_cast<unsigned long long int>(stoi(changes));
-          } catch (const std::exception &e) {
-            value = 0;
-          }
+        if (changes != nullptr && !db::helper::parse_number(changes, value)) {
+          value = 0;
         }
         if (sess_ != nullptr) {
           sess_->set_last_number_of_changes(value);
@@ -75,9 +136,11 @@ namespace coda::db::postgres {
           throw database_exception("statement::results invalid database");
         }
 
-        PGresult *res = PQexecParams(sess_->db_.get(), sql_.c_str(),
-                                     static_cast<int>(bindings_.num_of_bindings()), bindings_.types_,
-                                     bindings_.values_, bindings_.lengths_, bindings_.formats_, 0);
+        prepare_on_server();
+
+        PGresult *res = PQexecPrepared(sess_->db_.get(), name_.c_str(), static_cast<int>(types_.size()),
+                                       bindings_.values_, bindings_.lengths_, bindings_.formats_,
+                                       sess_->binary_results() ? 1 : 0);
 
         if (PQresultStatus(res) != PGRES_TUPLES_OK) {
           throw database_exception(last_error());
@@ -93,9 +156,11 @@ namespace coda::db::postgres {
           throw database_exception("statement::results invalid database");
         }
 
-        PGresult *res = PQexecParams(sess_->db_.get(), sql_.c_str(),
-                                     static_cast<int>(bindings_.num_of_bindings()), bindings_.types_,
-                                     bindings_.values_, bindings_.lengths_, bindings_.formats_, 0);
+        prepare_on_server();
+
+        PGresult *res = PQexecPrepared(sess_->db_.get(), name_.c_str(), static_cast<int>(types_.size()),
+                                       bindings_.values_, bindings_.lengths_, bindings_.formats_,
+                                       sess_->binary_results() ? 1 : 0);
 
         if (PQresultStatus(res) != PGRES_COMMAND_OK && PQresultStatus(res) != PGRES_TUPLES_OK) {
           PQclear(res);
@@ -109,6 +174,7 @@ namespace coda::db::postgres {
 
       void statement::finish() {
         stmt_ = nullptr;
+        deallocate();
         sql_.clear();
       }
 
@@ -134,13 +200,19 @@ namespace coda::db::postgres {
         if (PQntuples(stmt_.get()) <= 0) {
           return value;
         }
-        auto val = PQgetvalue(stmt_.get(), 0, 0);
-        if (val != nullptr) {
+        if (PQfformat(stmt_.get(), 0) != 0) {
           try {
-            value = stoll(val);
+            value = data_mapper::to_value(PQftype(stmt_.get(), 0), PQgetvalue(stmt_.get(), 0, 0),
+                                          PQgetlength(stmt_.get(), 0, 0), 1)
+                        .as<long long>();
           } catch (const std::exception &e) {
             value = 0;
           }
+        } else {
+          auto val = PQgetvalue(stmt_.get(), 0, 0);
+          if (val != nullptr && !db::helper::parse_number(val, value)) {
+            value = 0;
+          }
         }
 
         sess_->set_last_insert_id(value);
@@ -6,6 +6,7 @@
 #define CODA_DB_POSTGRES_STATEMENT_H
 
 #include <libpq-fe.h>
+#include <vector>
 #include "../statement.h"
 #include "binding.h"
 
@@ -13,7 +14,9 @@ namespace coda::db::postgres {
       class session;
 
       /*!
-       * a sqlite specific implementation of a statement
+       * a postgres specific implementation of a statement.
+       * the sql is prepared on the server when first executed, and
+       * is deallocated when the statement is finished.
        */
       class statement : public coda::db::statement {
        private:
@@ -21,6 +24,12 @@ namespace coda::db::postgres {
         std::shared_ptr<PGresult> stmt_;
         binding bindings_;
         std::string sql_;
+        std::string name_;
+        std::weak_ptr<PGconn> conn_;
+        std::vector<Oid> types_;
+
+        void prepare_on_server();
+        void deallocate() noexcept;
 
        public:
         /*!
@@ -33,11 +42,12 @@ namespace coda::db::postgres {
         statement(statement &&other) noexcept = default;
         statement &operator=(const statement &other) = delete;
         statement &operator=(statement &&other) noexcept = default;
-        ~statement() override = default;
+        ~statement() override;
 
         /* statement overrides */
         void prepare(const std::string &sql) override;
         bool is_valid() const noexcept override;
+        bool is_busy() const noexcept override;
         resultset_type query() override;
         bool execute() override;
         void finish() override;
@@ -10,14 +10,14 @@ using namespace std;
 
 namespace coda::db {
   query::query(const std::shared_ptr<coda::db::session> &session)
-      : dirty_(false), session_(session), stmt_(nullptr), params_(), named_params_() {
+      : dirty_(false), rebind_(false), session_(session), stmt_(nullptr), params_(), named_params_() {
     if (session_ == nullptr) {
       throw database_exception("No database provided for query");
     }
   }
 
   query::query(const query &other) noexcept
-      : bindable(other), sql_generator(other), dirty_(false),
+      : bindable(other), sql_generator(other), dirty_(false), rebind_(true),
         session_(other.session_),
         stmt_(other.stmt_),
         params_(other.params_),
@@ -25,6 +25,7 @@ namespace coda::db {
 
   query::query(query &&other) noexcept
       : dirty_(false),
+        rebind_(other.rebind_),
         session_(std::move(other.session_)),
         stmt_(std::move(other.stmt_)),
         params_(std::move(other.params_)),
@@ -35,6 +36,7 @@ namespace coda::db {
 
   query &query::operator=(const query &other) {
     dirty_ = other.dirty_;
+    rebind_ = true;
     session_ = other.session_;
     stmt_ = other.stmt_;
     params_ = other.params_;
@@ -44,6 +46,7 @@ namespace coda::db {
 
   query &query::operator=(query &&other) noexcept {
     dirty_ = other.dirty_;
+    rebind_ = other.rebind_;
     session_ = std::move(other.session_);
     stmt_ = std::move(other.stmt_);
     params_ = std::move(other.params_);
@@ -58,10 +61,11 @@ namespace coda::db {
 
   void query::prepare(const string &sql) {
     if (stmt_ == nullptr || dirty_) {
-      stmt_ = session_->create_statement();
-
-      stmt_->prepare(sql);
-    } else if (!dirty_) {
+      // return the old statement first, it may be for the same sql
+      stmt_ = nullptr;
+      stmt_ = session_->prepare_statement(sql);
+      rebind_ = true;
+    } else if (!rebind_) {
       return;
     }
 
@@ -76,6 +80,7 @@ namespace coda::db {
     }
 
     dirty_ = false;
+    rebind_ = false;
   }
 
   size_t query::assert_binding_index(size_t index) {
@@ -85,7 +90,7 @@ namespace coda::db {
 
     if (index > params_.size()) {
       params_.resize(index);
-      dirty_ = true;
+      rebind_ = true;
     }
 
     return index - 1;
@@ -98,13 +103,14 @@ namespace coda::db {
 
   bindable &query::bind(size_t index, const sql_value &value) {
     params_[assert_binding_index(index)] = value;
-    set_modified();
+    // only the values changed, the prepared statement can be reused
+    rebind_ = true;
     return *this;
   }
 
   bindable &query::bind(const string &name, const sql_value &value) {
     named_params_[name] = value;
-    set_modified();
+    rebind_ = true;
     return *this;
   }
 
@@ -124,6 +130,7 @@ namespace coda::db {
     params_.clear();
     named_params_.clear();
     dirty_ = false;
+    rebind_ = false;
     stmt_->reset();
   }
 }  // namespace coda::db
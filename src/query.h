@@ -37,6 +37,7 @@ namespace coda::db {
     size_t assert_binding_index(size_t index);
 
     bool dirty_;
+    bool rebind_;
 
    protected:
     std::shared_ptr<session_type> session_;
@@ -45,7 +46,9 @@ namespace coda::db {
     std::unordered_map<std::string, sql_value> named_params_;
 
     /*!
-     * prepares this query for the sql string
+     * prepares this query for the sql string.
+     * a new statement is only prepared when the query structure was modified,
+     * otherwise changed values are bound to the existing statement.
      * @param sql the sql string
      */
     void prepare(const std::string &sql);
@@ -57,6 +60,9 @@ namespace coda::db {
 
     bindable &bind(const std::string &name, const sql_value &value) override;
 
+    /*!
+     * marks the structure of this query as changed, requiring new sql and a new statement
+     */
     virtual void set_modified();
 
    public:
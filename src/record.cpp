@@ -1,4 +1,5 @@
 #include "record.h"
+#include <algorithm>
 #include "delete_query.h"
 #include "insert_query.h"
 #include "update_query.h"
@@ -9,7 +10,7 @@ namespace coda::db {
      * @param schema the schema to operate on
      * @param columnName the name of the id column in the schema
      */
-    record::record(const std::shared_ptr<schema_type> &schema) : schema_(schema) {
+    record::record(const std::shared_ptr<schema_type> &schema) : schema_(schema), persisted_(false) {
       if (schema_ == nullptr) {
         throw database_exception("no schema for record");
       }
@@ -23,7 +24,14 @@ namespace coda::db {
     /*!
      * move constructor
      */
-    record::record(record &&other) noexcept : schema_(std::move(other.schema_)), values_(std::move(other.values_)) {}
+    record::record(record &&other) noexcept
+        : schema_(std::move(other.schema_)),
+          index_(std::move(other.index_)),
+          values_(std::move(other.values_)),
+          present_(std::move(other.present_)),
+          dirty_(std::move(other.dirty_)),
+          extra_(std::move(other.extra_)),
+          persisted_(other.persisted_) {}
 
     /*!
      * assignment operator
@@ -36,6 +44,11 @@ namespace coda::db {
     record &record::operator=(record &&other) noexcept {
       values_ = std::move(other.values_);
       schema_ = std::move(other.schema_);
+      index_ = std::move(other.index_);
+      present_ = std::move(other.present_);
+      dirty_ = std::move(other.dirty_);
+      extra_ = std::move(other.extra_);
+      persisted_ = other.persisted_;
       return *this;
     }
 
@@ -47,13 +60,59 @@ namespace coda::db {
         return;
       }
 
+      layout();
+
       for (auto v = values.begin(); v != values.end(); ++v) {
-        set(v.name(), v->value());
+        auto name = v.name();
+        auto index = ordinal(name);
+
+        if (index == column_index::npos) {
+          set(name, v->value());
+          continue;
+        }
+
+        values_[index] = v->value();
+        present_[index] = true;
+        dirty_[index] = false;
       }
 
+      persisted_ = true;
+
       on_record_init(values);
     }
 
+    /*!
+     * initializes with the values of another record of the same table
+     */
+    void record::init(const record &values) {
+      index_ = values.index_;
+      values_ = values.values_;
+      present_ = values.present_;
+      dirty_.assign(values_.size(), false);
+      extra_ = values.extra_;
+      persisted_ = values.persisted_;
+
+      // the same hook as a record read from a row
+      std::vector<std::string> names;
+      auto copies = std::make_shared<std::vector<sql_value>>();
+
+      for (size_t i = 0; i < values_.size(); i++) {
+        if (present_[i]) {
+          names.push_back(index_->name(i));
+          copies->push_back(values_[i]);
+        }
+      }
+
+      for (auto &extra : extra_) {
+        names.push_back(extra.first);
+        copies->push_back(extra.second);
+      }
+
+      auto columns = std::make_shared<column_index>(names, index_ != nullptr && index_->ignore_case());
+
+      on_record_init(row(std::make_shared<copied_row>(copies, columns)));
+    }
+
     /*!
      * called when a record is read from the database
      * Overide in subclasses for custom loading actions
@@ -97,14 +156,35 @@ namespace coda::db {
 
     /*!
      * saves this instance
-     * @param insert_only set to true to never perform an update if the record
-     * exists
      * @return true if the save was successful
      */
     bool record::save() {
+      auto pk = schema()->primary_key();
+
+      // a changed id on a persisted record no longer identifies the row it was loaded from
+      if (persisted_ && has(pk) && !is_dirty(pk)) {
+        auto cols_to_save = dirty_columns(pk);
+
+        if (cols_to_save.empty()) {
+          return true;
+        }
+
+        update_query query(schema(), cols_to_save);
+
+        query.bind(get(cols_to_save));
+
+        query.where(op::equals(pk, get(pk)));
+
+        if (query.execute() == 0) {
+          return false;
+        }
+
+        mark_clean();
+        return true;
+      }
+
       bool result;
       bool exists = record::exists();
-      auto pk = schema()->primary_key();
       auto cols_to_save = available_columns(exists, pk);
 
       if (exists) {
@@ -128,9 +208,59 @@ namespace coda::db {
         }
       }
 
+      if (result) {
+        mark_clean();
+      }
+
       return result;
     }
 
+    /*!
+     * inserts or updates this instance in a single statement
+     * @return true if the upsert was successful
+     */
+    bool record::upsert() {
+      auto pk = schema()->primary_key();
+      auto cols_to_save = available_columns(true, pk);
+
+      insert_query query(schema(), cols_to_save);
+
+      query.on_conflict();
+
+      query.bind(get(cols_to_save));
+
+      // mysql counts an unchanged row as no change, so only a thrown error is a failure
+      query.execute();
+
+      if (!has(pk)) {
+        // set the new id
+        set(pk, query.last_insert_id());
+      }
+
+      mark_clean();
+      return true;
+    }
+
+    /*!
+     * @return true if the record was loaded from or saved to the database
+     */
+    bool record::is_persisted() const { return persisted_; }
+
+    /*!
+     * @return true if any column has changed
+     */
+    bool record::is_dirty() const { return std::find(dirty_.begin(), dirty_.end(), true) != dirty_.end(); }
+
+    /*!
+     * @param name the name of the column to check
+     * @return true if the column has changed
+     */
+    bool record::is_dirty(const std::string &name) const {
+      auto index = ordinal(name);
+
+      return index != column_index::npos && dirty_[index];
+    }
+
     /*!
      * @return the id of the record
      */
@@ -141,11 +271,15 @@ namespace coda::db {
      * @return a value specified by column name
      */
     sql_value record::get(const std::string &name) const {
-      if (!has(name)) {
-        return sql_null;
+      auto index = ordinal(name);
+
+      if (index != column_index::npos) {
+        return present_[index] ? values_[index] : sql_null;
       }
 
-      return values_.at(name);
+      auto it = find_extra(name);
+
+      return it == extra_.end() ? sql_null : it->second;
     }
 
     /*!
@@ -170,7 +304,13 @@ namespace coda::db {
      * NOTE: you may need to 'refresh' from the db to get all columns
      */
     bool record::has(const std::string &name) const {
-      return !name.empty() && !values_.empty() && values_.count(name) > 0;
+      auto index = ordinal(name);
+
+      if (index != column_index::npos) {
+        return present_[index];
+      }
+
+      return find_extra(name) != extra_.end();
     }
 
     /*!
@@ -183,18 +323,60 @@ namespace coda::db {
      * @param name the name of the column to set
      * @param value the value to set for the column
      */
-    void record::set(const std::string &name, const sql_value &value) { values_[name] = value; }
+    void record::set(const std::string &name, const sql_value &value) {
+      layout();
+
+      auto index = ordinal(name);
+
+      if (index != column_index::npos) {
+        values_[index] = value;
+        present_[index] = true;
+        dirty_[index] = true;
+        return;
+      }
+
+      auto it = find_extra(name);
+
+      if (it != extra_.end()) {
+        extra_[static_cast<size_t>(it - extra_.cbegin())].second = value;
+      } else if (!name.empty()) {
+        extra_.emplace_back(name, value);
+      }
+    }
 
     /*!
      * unsets / removes a column
      * @param name the name of the column to unset
      */
-    void record::unset(const std::string &name) { values_.erase(name); }
+    void record::unset(const std::string &name) {
+      auto index = ordinal(name);
+
+      if (index != column_index::npos) {
+        values_[index] = sql_value();
+        present_[index] = false;
+        dirty_[index] = false;
+        return;
+      }
+
+      auto it = find_extra(name);
+
+      if (it != extra_.end()) {
+        extra_.erase(it);
+      }
+    }
 
     /*!
      * clears values set on this object
      */
-    void record::reset() { values_.clear(); }
+    void record::reset() {
+      // the next value set lays out the record again, in case the schema has changed
+      index_ = nullptr;
+      values_.clear();
+      present_.clear();
+      dirty_.clear();
+      extra_.clear();
+      persisted_ = false;
+    }
 
     /*!
      * refreshes from the database for the value in the id column
@@ -233,7 +415,7 @@ namespace coda::db {
     /*!
      * deletes this record from the database for the value in the id column
      */
-    bool record::remove() const {
+    bool record::remove() {
       auto pk = schema()->primary_key();
 
       if (!has(pk)) {
@@ -243,7 +425,16 @@ namespace coda::db {
 
       query.where(op::equals(pk, get(pk)));
 
-      return query.execute() != 0;
+      auto result = query.execute() != 0;
+
+      record_cache::global().erase(*schema(), get(pk));
+
+      // a later save inserts the record again
+      if (result) {
+        persisted_ = false;
+      }
+
+      return result;
     }
 
     /*!
@@ -253,13 +444,77 @@ namespace coda::db {
      */
     std::vector<std::string> record::available_columns(bool exists, const std::string &pk) const {
       std::vector<std::string> values;
-      auto columns = schema()->column_names();
-      values.resize(columns.size());
-      auto it = std::copy_if(columns.begin(), columns.end(), values.begin(),
-                             [&](const std::string &val) { return has(val) && (exists || val != pk); });
-      values.resize(static_cast<unsigned long>(std::distance(values.begin(), it)));
+      for (size_t i = 0; i < values_.size(); i++) {
+        if (present_[i] && (exists || index_->name(i) != pk)) {
+          values.push_back(index_->name(i));
+        }
+      }
+      return values;
+    }
+
+    /*!
+     * @param pk the primary key column name
+     * @return a vector of changed columns in schema order
+     */
+    std::vector<std::string> record::dirty_columns(const std::string &pk) const {
+      std::vector<std::string> values;
+      for (size_t i = 0; i < values_.size(); i++) {
+        if (dirty_[i] && present_[i] && index_->name(i) != pk) {
+          values.push_back(index_->name(i));
+        }
+      }
       return values;
     }
+
+    /*!
+     * marks the record as matching the database
+     */
+    void record::mark_clean() {
+      std::fill(dirty_.begin(), dirty_.end(), false);
+      persisted_ = true;
+
+      // a cached copy is stale once the record is written
+      record_cache::global().erase(*schema(), id());
+    }
+
+    /*!
+     * @param name the name of the column
+     * @return the position of the column in the values, or column_index::npos
+     */
+    size_t record::ordinal(const std::string &name) const {
+      if (index_ == nullptr) {
+        return column_index::npos;
+      }
+      return index_->find(name);
+    }
+
+    /*!
+     * sizes the values for the columns of the schema
+     */
+    void record::layout() {
+      if (index_ != nullptr) {
+        return;
+      }
+
+      index_ = schema()->index();
+
+      if (index_ == nullptr) {
+        index_ = std::make_shared<column_index>(std::vector<std::string>());
+      }
+
+      values_.resize(index_->size());
+      present_.resize(index_->size());
+      dirty_.resize(index_->size());
+    }
+
+    /*!
+     * @param name the name of a column outside the schema
+     * @return the value of the column, or the end of the values
+     */
+    std::vector<std::pair<std::string, sql_value>>::const_iterator record::find_extra(const std::string &name) const {
+      return std::find_if(extra_.begin(), extra_.end(),
+                          [&name](const std::pair<std::string, sql_value> &value) { return value.first == name; });
+    }
   }  // namespace base
 
   /*!
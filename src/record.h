@@ -8,22 +8,34 @@
 
 #include <algorithm>
 #include <memory>
+#include "column_index.h"
+#include "record_cache.h"
 #include "schema.h"
 #include "select_query.h"
 
 namespace coda::db {
+  class unit_of_work;
 
   namespace base {
     /*!
      * base class for a record
      */
     class record {
+      friend class coda::db::unit_of_work;
+
      public:
       using schema_type = coda::db::schema;
 
      private:
       std::shared_ptr<schema_type> schema_;
-      std::unordered_map<std::string, sql_value> values_;
+      // values in schema order, laid out by the column index of the schema
+      std::shared_ptr<column_index> index_;
+      std::vector<sql_value> values_;
+      std::vector<bool> present_;
+      std::vector<bool> dirty_;
+      // values for columns outside the schema, which are never saved
+      std::vector<std::pair<std::string, sql_value>> extra_;
+      bool persisted_;
 
      public:
       /*!
@@ -64,6 +76,12 @@ namespace coda::db {
        */
       void init(const row &values);
 
+      /*!
+       * initializes with the values of another record of the same table, such as a cached copy.
+       * on_record_init is called with a row of the copied values.
+       */
+      void init(const record &values);
+
       /*!
        * called when a record is read from the database
        * Overide in subclasses for custom loading actions
@@ -89,12 +107,35 @@ namespace coda::db {
 
       /*!
        * saves this instance
-       * @param insert_only set to true to never perform an update if the
-       * record exists
+       * A record loaded from or saved to the database updates only its changed columns, or does nothing when
+       * unchanged. Other records check if they exist first.
        * @return true if the save was successful
        */
       bool save();
 
+      /*!
+       * inserts this instance, or updates the row with the same primary key, in a single statement
+       * @return true if the upsert was successful, including when the row was already unchanged
+       * @throws database_exception if the statement fails
+       */
+      bool upsert();
+
+      /*!
+       * @return true if the record was loaded from or saved to the database
+       */
+      bool is_persisted() const;
+
+      /*!
+       * @return true if any column has changed since the record was loaded or saved
+       */
+      bool is_dirty() const;
+
+      /*!
+       * @param name the name of the column to check
+       * @return true if the column has changed since the record was loaded or saved
+       */
+      bool is_dirty(const std::string &name) const;
+
       /*!
        * the id of the record
        */
@@ -161,10 +202,15 @@ namespace coda::db {
       /*!
        * deletes this record from the database for the value in the id column
        */
-      bool remove() const;
+      bool remove();
 
      private:
       std::vector<std::string> available_columns(bool exists, const std::string &pk) const;
+      std::vector<std::string> dirty_columns(const std::string &pk) const;
+      void mark_clean();
+      size_t ordinal(const std::string &name) const;
+      void layout();
+      std::vector<std::pair<std::string, sql_value>>::const_iterator find_extra(const std::string &name) const;
     };
   }  // namespace base
 
@@ -659,7 +705,7 @@ namespace coda::db {
   }
 
   /*!
-   * finds a record by its id
+   * finds a record by its id, from the global record cache when it is enabled
    * @param schema the schema to find
    * @param value the value of the column to find
    * @param funk the callback
@@ -667,7 +713,25 @@ namespace coda::db {
   template<typename T, typename = std::enable_if<std::is_base_of<base::record, T>::value>>
   inline void find_by_id(const std::shared_ptr<schema> &schema, const sql_value &value,
                          const std::function<void(const std::shared_ptr<T> &)> &funk) {
-    find_one<T>(schema, {{schema->primary_key(), value}}, funk);
+    if (!schema) {
+      return;
+    }
+
+    auto &cache = record_cache::global();
+
+    auto cached = cache.get(*schema, value);
+
+    if (cached != nullptr) {
+      auto record = std::make_shared<T>(schema);
+      record->init(*cached);
+      funk(record);
+      return;
+    }
+
+    find_one<T>(schema, {{schema->primary_key(), value}}, [&cache, &funk](const std::shared_ptr<T> &record) {
+      cache.put(*record);
+      funk(record);
+    });
   }
 
   /*!
@@ -678,7 +742,7 @@ namespace coda::db {
    */
   inline void find_by_id(const std::shared_ptr<schema> &schema, const sql_value &value,
                          const std::function<void(const std::shared_ptr<generic::record> &)> &funk) {
-    find_one<generic::record>(schema, {{schema->primary_key(), value}}, funk);
+    find_by_id<generic::record>(schema, value, funk);
   }
 
   /*!
@@ -689,7 +753,12 @@ namespace coda::db {
    */
   template<typename T, typename = std::enable_if<std::is_base_of<base::record, T>::value>>
   inline std::shared_ptr<T> find_by_id(const std::shared_ptr<schema> &schema, const sql_value &value) {
-    return find_one<T>(schema, {{schema->primary_key(), value}});
+    std::shared_ptr<T> item;
+
+    db::find_by_id<T>(schema, value, std::function<void(const std::shared_ptr<T> &)>(
+                                         [&item](const std::shared_ptr<T> &record) { item = record; }));
+
+    return item;
   }
 
   /*!
@@ -698,7 +767,7 @@ namespace coda::db {
    * @param value the value of the id to find
    */
   inline std::shared_ptr<generic::record> find_by_id(const std::shared_ptr<schema> &schema, const sql_value &value) {
-    return find_one<generic::record>(schema, {{schema->primary_key(), value}});
+    return find_by_id<generic::record>(schema, value);
   }
 
   /*!
@@ -0,0 +1,226 @@
+#include "record_cache.h"
+#include <list>
+#include <mutex>
+#include "exception.h"
+#include "record.h"
+#include "session.h"
+
+using namespace std;
+
+namespace coda::db {
+
+  namespace {
+    /**
+     * a key for a record that is unique across databases
+     */
+    string record_key(const schema &schema, const sql_value &id) {
+      string key = schema.get_session()->connection_info();
+      key += '\n';
+      key += schema.table_name();
+      key += '\n';
+      key += id.to_string();
+      return key;
+    }
+
+    /**
+     * the primary key of a record, or null when the record has none
+     */
+    sql_value record_id(const base::record &value) {
+      try {
+        return value.get(value.schema()->primary_key());
+      } catch (const no_primary_key_exception &) {
+        return sql_null;
+      }
+    }
+
+    /**
+     * rows read or written in a transaction may still be rolled back, so they are not shared
+     */
+    bool in_transaction(const schema &schema) {
+      auto session = schema.get_session();
+
+      return session != nullptr && session->in_transaction();
+    }
+  }  // namespace
+
+  struct record_cache::storage {
+    struct entry {
+      std::string key;
+      std::shared_ptr<const record_type> value;
+      clock_type::time_point expires;
+    };
+
+    storage(size_t capacity, clock_type::duration ttl) : capacity(capacity), ttl(ttl), hits(0), misses(0) {}
+
+    /* must be called with the lock held */
+    void trim(size_t size) {
+      while (lru.size() > size) {
+        index.erase(lru.back().key);
+        lru.pop_back();
+      }
+    }
+
+    /* must be called with the lock held */
+    void erase(const std::string &key) {
+      auto it = index.find(key);
+
+      if (it != index.end()) {
+        lru.erase(it->second);
+        index.erase(it);
+      }
+    }
+
+    mutable std::mutex mutex;
+    size_t capacity;
+    clock_type::duration ttl;
+    unsigned long long hits;
+    unsigned long long misses;
+    std::list<entry> lru;
+    std::unordered_map<std::string, std::list<entry>::iterator> index;
+  };
+
+  record_cache::record_cache(size_t capacity, clock_type::duration ttl)
+      : storage_(make_shared<storage>(capacity, ttl)) {}
+
+  record_cache &record_cache::global() {
+    static record_cache instance;
+    return instance;
+  }
+
+  shared_ptr<const record_cache::record_type> record_cache::get(const schema &schema, const sql_value &id) {
+    if (capacity() == 0 || id == sql_null || in_transaction(schema)) {
+      return nullptr;
+    }
+
+    auto key = record_key(schema, id);
+
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+
+    auto it = storage_->index.find(key);
+
+    if (it == storage_->index.end()) {
+      storage_->misses++;
+      return nullptr;
+    }
+
+    if (storage_->ttl != clock_type::duration::zero() && it->second->expires <= clock_type::now()) {
+      storage_->erase(key);
+      storage_->misses++;
+      return nullptr;
+    }
+
+    // most recently used first
+    storage_->lru.splice(storage_->lru.begin(), storage_->lru, it->second);
+
+    storage_->hits++;
+
+    return it->second->value;
+  }
+
+  void record_cache::put(const record_type &value) {
+    if (capacity() == 0) {
+      return;
+    }
+
+    auto id = record_id(value);
+
+    if (id == sql_null || in_transaction(*value.schema())) {
+      return;
+    }
+
+    auto key = record_key(*value.schema(), id);
+
+    // copied outside the lock
+    auto copy = make_shared<const record_type>(value);
+
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+
+    storage_->erase(key);
+
+    if (storage_->capacity == 0) {
+      return;
+    }
+
+    storage_->lru.push_front({key, copy, clock_type::now() + storage_->ttl});
+    storage_->index[key] = storage_->lru.begin();
+    storage_->trim(storage_->capacity);
+  }
+
+  void record_cache::erase(const schema &schema, const sql_value &id) {
+    if (capacity() == 0 || id == sql_null) {
+      return;
+    }
+
+    auto key = record_key(schema, id);
+
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    storage_->erase(key);
+  }
+
+  void record_cache::clear() {
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    storage_->trim(0);
+  }
+
+  size_t record_cache::size() const {
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    return storage_->lru.size();
+  }
+
+  size_t record_cache::capacity() const {
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    return storage_->capacity;
+  }
+
+  void record_cache::set_capacity(size_t value) {
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    storage_->capacity = value;
+    storage_->trim(value);
+  }
+
+  record_cache::clock_type::duration record_cache::ttl() const {
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    return storage_->ttl;
+  }
+
+  void record_cache::set_ttl(clock_type::duration value) {
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    storage_->ttl = value;
+  }
+
+  unsigned long long record_cache::hits() const {
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    return storage_->hits;
+  }
+
+  unsigned long long record_cache::misses() const {
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    return storage_->misses;
+  }
+
+  shared_ptr<identity_map::record_type> identity_map::get(const schema &schema, const sql_value &id) const {
+    auto it = records_.find(record_key(schema, id));
+
+    return it == records_.end() ? nullptr : it->second;
+  }
+
+  void identity_map::put(const shared_ptr<record_type> &value) {
+    if (value == nullptr) {
+      return;
+    }
+
+    auto id = record_id(*value);
+
+    if (id == sql_null) {
+      return;
+    }
+
+    records_[record_key(*value->schema(), id)] = value;
+  }
+
+  void identity_map::erase(const schema &schema, const sql_value &id) { records_.erase(record_key(schema, id)); }
+
+  void identity_map::clear() noexcept { records_.clear(); }
+
+  size_t identity_map::size() const noexcept { return records_.size(); }
+}  // namespace coda::db
@@ -0,0 +1,163 @@
+/*!
+ * @file record_cache.h
+ * caches of records keyed by their primary key
+ */
+#ifndef CODA_DB_RECORD_CACHE_H
+#define CODA_DB_RECORD_CACHE_H
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace coda::db {
+  class schema;
+
+  class sql_value;
+
+  namespace base {
+    class record;
+  }
+
+  /*!
+   *  Record cache keeps copies of records keyed by database, table and primary key.
+   *  Lookups by id are answered from the cache until the entry expires, is evicted as the
+   *  least recently used, or the record is saved or removed.  Changes made with queries
+   *  instead of records are not seen, so a time to live bounds how stale an entry can get.
+   *  While a session is in a transaction its records are neither kept nor served, so values
+   *  that may be rolled back are never shared.
+   */
+  class record_cache {
+   public:
+    using record_type = base::record;
+    using clock_type = std::chrono::steady_clock;
+
+    /*!
+     * @param capacity the maximum number of records, zero to disable
+     * @param ttl      how long a record is kept, zero to keep it until evicted
+     */
+    explicit record_cache(size_t capacity = 0, clock_type::duration ttl = clock_type::duration::zero());
+
+    /* boilerplate, copies share the same storage */
+    record_cache(const record_cache &other) = default;
+    record_cache(record_cache &&other) noexcept = default;
+    ~record_cache() = default;
+    record_cache &operator=(const record_cache &other) = default;
+    record_cache &operator=(record_cache &&other) noexcept = default;
+
+    /*!
+     * the process wide cache used by find_by_id, disabled until it is given a capacity
+     * @return the cache instance
+     */
+    static record_cache &global();
+
+    /*!
+     * @param schema the schema of the record
+     * @param id     the primary key of the record
+     * @return a copy of the record, or nullptr on a miss or in a transaction
+     */
+    std::shared_ptr<const record_type> get(const schema &schema, const sql_value &id);
+
+    /*!
+     * keeps a copy of a record.  records without a primary key, or read in a transaction, are ignored.
+     * @param value the record to keep
+     */
+    void put(const record_type &value);
+
+    /*!
+     * forgets a record
+     * @param schema the schema of the record
+     * @param id     the primary key of the record
+     */
+    void erase(const schema &schema, const sql_value &id);
+
+    /*!
+     * forgets all records
+     */
+    void clear();
+
+    /*!
+     * @return the number of records
+     */
+    size_t size() const;
+
+    /*!
+     * @return the maximum number of records
+     */
+    size_t capacity() const;
+
+    /*!
+     * @param value the maximum number of records, zero to disable
+     */
+    void set_capacity(size_t value);
+
+    /*!
+     * @return how long a record is kept
+     */
+    clock_type::duration ttl() const;
+
+    /*!
+     * @param value how long a record is kept, zero to keep it until evicted
+     */
+    void set_ttl(clock_type::duration value);
+
+    /*!
+     * @return the number of lookups found in the cache
+     */
+    unsigned long long hits() const;
+
+    /*!
+     * @return the number of lookups not found in the cache
+     */
+    unsigned long long misses() const;
+
+   private:
+    struct storage;
+
+    std::shared_ptr<storage> storage_;
+  };
+
+  /*!
+   *  Identity map keeps one instance of each record loaded in a scope, such as a unit of work,
+   *  so that finding the same id twice returns the same object.  It is not thread safe.
+   */
+  class identity_map {
+   public:
+    using record_type = base::record;
+
+    /*!
+     * @param schema the schema of the record
+     * @param id     the primary key of the record
+     * @return the record, or nullptr if it was not loaded
+     */
+    std::shared_ptr<record_type> get(const schema &schema, const sql_value &id) const;
+
+    /*!
+     * keeps a record.  records without a primary key are ignored.
+     * @param value the record to keep
+     */
+    void put(const std::shared_ptr<record_type> &value);
+
+    /*!
+     * forgets a record
+     * @param schema the schema of the record
+     * @param id     the primary key of the record
+     */
+    void erase(const schema &schema, const sql_value &id);
+
+    /*!
+     * forgets all records
+     */
+    void clear() noexcept;
+
+    /*!
+     * @return the number of records
+     */
+    size_t size() const noexcept;
+
+   private:
+    std::unordered_map<std::string, std::shared_ptr<record_type>> records_;
+  };
+}  // namespace coda::db
+
+#endif
@@ -7,6 +7,168 @@ using namespace std;
 
 namespace coda::db {
 
+  size_t resultset_impl::column_count() { return current_row().size(); }
+
+  sql_value resultset_impl::column_value(size_t index) { return current_row().column(index).value(); }
+
+  string resultset_impl::column_name(size_t index) { return current_row().column_name(index); }
+
+  bool resultset_impl::column_is_null(size_t index) { return column_value(index) == sql_null; }
+
+  long long resultset_impl::column_int64(size_t index) {
+    auto value = column_value(index);
+    return value == sql_null ? 0 : value.as<long long>();
+  }
+
+  double resultset_impl::column_double(size_t index) {
+    auto value = column_value(index);
+    return value == sql_null ? 0 : value.as<double>();
+  }
+
+  string resultset_impl::column_text(size_t index) {
+    auto value = column_value(index);
+    return value == sql_null ? string() : value.as<string>();
+  }
+
+  batch_column::type resultset_impl::batch_type(size_t index) {
+    auto value = column_value(index);
+
+    if (value.is<sql_number>()) {
+      auto number = value.as<sql_number>();
+      return number.is<double>() || number.is<float>() || number.is<long double>() ? batch_column::real
+                                                                                    : batch_column::integer;
+    }
+
+    if (value.is<sql_blob>()) {
+      return batch_column::blob;
+    }
+
+    return batch_column::text;
+  }
+
+  void resultset_impl::append_batch(column_batch &batch) {
+    for (size_t i = 0; i < batch.column_count(); i++) {
+      auto &column = batch.column(i);
+
+      if (column_is_null(i)) {
+        column.append_null();
+        continue;
+      }
+
+      switch (column.kind()) {
+        case batch_column::integer:
+          column.append(column_int64(i));
+          break;
+        case batch_column::real:
+          column.append(column_double(i));
+          break;
+        case batch_column::text: {
+          auto text = column_text(i);
+          column.append(text.data(), text.size());
+          break;
+        }
+        case batch_column::blob: {
+          auto blob = column_value(i).as<sql_blob>();
+          column.append(static_cast<const char *>(blob.get()), blob.size());
+          break;
+        }
+      }
+    }
+  }
+
+  size_t resultset_impl::fetch_batch(column_batch &batch, size_t size) {
+    if (!is_started()) {
+      advance();
+    }
+
+    if (!has_row()) {
+      batch.reset(columns(), batchTypes_);
+      return 0;
+    }
+
+    // decide the storage once, from the first row read
+    if (batchTypes_.empty()) {
+      auto count = column_count();
+
+      batchTypes_.reserve(count);
+
+      for (size_t i = 0; i < count; i++) {
+        batchTypes_.push_back(batch_type(i));
+      }
+    }
+
+    batch.reset(columns(), batchTypes_);
+
+    size_t count = 0;
+
+    while (count < size && has_row()) {
+      append_batch(batch);
+      count++;
+      advance();
+    }
+
+    return count;
+  }
+
+  string_view resultset_impl::column_data(size_t index) {
+    // views point into the driver's buffers, so they outlive the column
+    return current_row().column(index).as_view();
+  }
+
+  size_t resultset_impl::row_count() { return npos; }
+
+  bool resultset_impl::advance() {
+    started_ = true;
+    hasRow_ = next();
+    return hasRow_;
+  }
+
+  void resultset_impl::rewind() {
+    if (started_) {
+      reset();
+    }
+    started_ = false;
+    hasRow_ = false;
+  }
+
+  bool resultset_impl::is_started() const noexcept { return started_; }
+
+  bool resultset_impl::has_row() const noexcept { return hasRow_; }
+
+  shared_ptr<column_index> resultset_impl::columns() {
+    if (columns_ != nullptr) {
+      return columns_;
+    }
+
+    auto count = column_count();
+
+    vector<string> names;
+
+    names.reserve(count);
+
+    for (size_t i = 0; i < count; i++) {
+      names.push_back(column_name(i));
+    }
+
+    auto value = make_shared<column_index>(names, ignoreCase_);
+
+    // some results only know their columns once executed
+    if (count > 0) {
+      columns_ = value;
+    }
+
+    return value;
+  }
+
+  void resultset_impl::set_ignore_case(bool value) {
+    if (value != ignoreCase_) {
+      ignoreCase_ = value;
+      columns_ = nullptr;
+    }
+  }
+
+  bool resultset_impl::ignore_case() const noexcept { return ignoreCase_; }
+
   resultset::resultset(const shared_ptr<resultset_impl> &impl) : impl_(impl) {
     if (impl_ == nullptr) {
       throw database_exception("no implementation provided for resultset");
@@ -23,6 +185,18 @@ namespace coda::db {
 
   resultset_impl::row_type resultset::operator*() { return impl_->current_row(); }
 
+  row_view resultset::view() const { return row_view(impl_.get()); }
+
+  void resultset::set_ignore_case(bool value) { impl_->set_ignore_case(value); }
+
+  column_batch resultset::fetch_batch(size_t size) const {
+    column_batch batch;
+    impl_->fetch_batch(batch, size);
+    return batch;
+  }
+
+  size_t resultset::fetch_batch(column_batch &batch, size_t size) const { return impl_->fetch_batch(batch, size); }
+
   bool resultset::is_valid() const noexcept { return impl_ != nullptr && impl_->is_valid(); }
 
   resultset_impl::row_type resultset::current_row() {
@@ -30,13 +204,39 @@ namespace coda::db {
     return impl_->current_row();
   }
 
-  bool resultset::next() { return impl_->next(); }
+  bool resultset::next() { return impl_->advance(); }
+
+  void resultset::reset() { impl_->rewind(); }
+
+  size_t resultset::size() const {
+    auto count = impl_->row_count();
+
+    if (count != resultset_impl::npos) {
+      return count;
+    }
+
+    impl_->rewind();
+
+    count = 0;
+
+    while (impl_->advance()) {
+      count++;
+    }
+
+    impl_->rewind();
+
+    return count;
+  }
 
-  void resultset::reset() { impl_->reset(); }
+  bool resultset::empty() const {
+    auto count = impl_->row_count();
 
-  size_t resultset::size() const { return static_cast<size_t>(distance(begin(), end())); }
+    if (count != resultset_impl::npos) {
+      return count == 0;
+    }
 
-  bool resultset::empty() const { return begin() == end(); }
+    return begin() == end();
+  }
 
   void resultset::each(const std::function<void(const row &row)> &funk) const {
     for (auto &row : *this) {
@@ -44,10 +244,25 @@ namespace coda::db {
     }
   }
 
+  void resultset::each_view(const std::function<void(const row_view &)> &funk) const {
+    if (!impl_->is_started()) {
+      impl_->advance();
+    }
+
+    row_view view(impl_.get());
+
+    while (impl_->has_row()) {
+      funk(view);
+      impl_->advance();
+    }
+  }
+
   resultset::iterator resultset::begin() {
-    impl_->reset();
+    if (!impl_->is_started()) {
+      impl_->advance();
+    }
 
-    if (impl_->next())
+    if (impl_->has_row())
       return iterator(impl_, 0);
     else
       return end();
@@ -56,9 +271,11 @@ namespace coda::db {
   resultset::iterator resultset::end() { return iterator(impl_, -1); }
 
   resultset::const_iterator resultset::begin() const {
-    impl_->reset();
+    if (!impl_->is_started()) {
+      impl_->advance();
+    }
 
-    if (impl_->next())
+    if (impl_->has_row())
       return const_iterator(impl_, 0);
     else
       return end();
@@ -6,7 +6,14 @@
 #define CODA_DB_RESULTSET_H
 
 #include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "column_batch.h"
+#include "column_index.h"
 #include "row.h"
+#include "row_view.h"
 
 namespace coda::db {
   class resultset;
@@ -18,10 +25,22 @@ namespace coda::db {
    public:
     typedef coda::db::row row_type;
 
+   private:
+    std::shared_ptr<column_index> columns_;
+    std::vector<batch_column::type> batchTypes_;
+    bool ignoreCase_ = false;
+    bool started_ = false;
+    bool hasRow_ = false;
+
    protected:
     resultset_impl() = default;
 
    public:
+    /*!
+     * the row count returned when the number of rows is unknown
+     */
+    static const size_t npos = static_cast<size_t>(-1);
+
     /* non-copyable */
     resultset_impl(const resultset_impl &other) = delete;
 
@@ -55,6 +74,138 @@ namespace coda::db {
      * resets this resultset back to the first row
      */
     virtual void reset() = 0;
+
+    /*!
+     * gets the number of columns in the current row.
+     * implementations should override to avoid creating a row.
+     * @return the number of columns
+     */
+    virtual size_t column_count();
+
+    /*!
+     * gets a value in the current row.
+     * implementations should override to read the value without creating a row and column.
+     * @param index the index of the column
+     * @return the value of the column
+     */
+    virtual sql_value column_value(size_t index);
+
+    /*!
+     * gets the name of a column in the current row
+     * @param index the index of the column
+     * @return the name of the column
+     */
+    virtual std::string column_name(size_t index);
+
+    /*!
+     * tests a value in the current row for null.
+     * implementations should override to check without creating a value.
+     * @param index the index of the column
+     * @return true if the value is null
+     */
+    virtual bool column_is_null(size_t index);
+
+    /*!
+     * gets a value in the current row as an integer.
+     * implementations should override to decode without creating a value.
+     * @param index the index of the column
+     * @return the integer value, or zero if null
+     */
+    virtual long long column_int64(size_t index);
+
+    /*!
+     * gets a value in the current row as a floating point number.
+     * implementations should override to decode without creating a value.
+     * @param index the index of the column
+     * @return the floating point value, or zero if null
+     */
+    virtual double column_double(size_t index);
+
+    /*!
+     * gets a value in the current row as text.
+     * implementations should override to decode without creating a value.
+     * @param index the index of the column
+     * @return the text value, or empty if null
+     */
+    virtual std::string column_text(size_t index);
+
+    /*!
+     * gets the bytes of a text or blob value in the current row without copying.
+     * implementations should override to view the value without creating a row and column.
+     * @param index the index of the column
+     * @return a view that is only valid until the results move to another row
+     */
+    virtual std::string_view column_data(size_t index);
+
+    /*!
+     * gets the type a column is stored as in a batch, from the current row.
+     * implementations should override to use the column type of the results.
+     * @param index the index of the column
+     * @return the storage type
+     */
+    virtual batch_column::type batch_type(size_t index);
+
+    /*!
+     * appends the current row to a batch.
+     * implementations should override to decode the values directly.
+     * @param batch the batch to append to
+     */
+    virtual void append_batch(column_batch &batch);
+
+    /*!
+     * reads rows into a batch, starting at the current row or the first if not started.
+     * the column storage types are decided once for the results.
+     * @param batch the batch to fill, storage is reused if the columns are the same
+     * @param size  the maximum number of rows to read
+     * @return the number of rows read
+     */
+    size_t fetch_batch(column_batch &batch, size_t size);
+
+    /*!
+     * gets the number of rows without reading them.
+     * implementations should override if the backend knows the count.
+     * @return the number of rows or npos if unknown
+     */
+    virtual size_t row_count();
+
+    /*!
+     * moves to the next row, remembering where iteration is
+     * @return true if there is a current row
+     */
+    bool advance();
+
+    /*!
+     * moves back to before the first row.  the results are only reset
+     * if iteration has started.
+     */
+    void rewind();
+
+    /*!
+     * @return true if the results have been advanced since created or rewound
+     */
+    bool is_started() const noexcept;
+
+    /*!
+     * @return true if there is a current row
+     */
+    bool has_row() const noexcept;
+
+    /*!
+     * gets the index of column names, built once when the columns are known
+     * and shared with each row
+     * @return the column index
+     */
+    std::shared_ptr<column_index> columns();
+
+    /*!
+     * @param value true to match column names case insensitively
+     */
+    void set_ignore_case(bool value);
+
+    /*!
+     * @return true if column names are matched case insensitively
+     */
+    bool ignore_case() const noexcept;
   };
 
   /*!
@@ -102,7 +253,7 @@ namespace coda::db {
         return *this;
       }
 
-      bool res = rs_->next();
+      bool res = rs_->advance();
 
       if (res) {
         pos_++;
@@ -160,6 +311,136 @@ namespace coda::db {
     bool operator>=(const resultset_iterator &other) const { return operator>(other) || operator==(other); }
   };
 
+  namespace helper {
+    /*!
+     * reads a column of the current row as a type, falling back to converting a value
+     */
+    template<typename T, typename = void>
+    struct column_reader {
+      static T read(resultset_impl *rs, size_t index) { return rs->column_value(index).as<T>(); }
+    };
+
+    template<>
+    struct column_reader<sql_value> {
+      static sql_value read(resultset_impl *rs, size_t index) { return rs->column_value(index); }
+    };
+
+    template<typename T>
+    struct column_reader<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+      static T read(resultset_impl *rs, size_t index) { return static_cast<T>(rs->column_int64(index)); }
+    };
+
+    template<typename T>
+    struct column_reader<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+      static T read(resultset_impl *rs, size_t index) { return static_cast<T>(rs->column_double(index)); }
+    };
+
+    template<>
+    struct column_reader<std::string> {
+      static std::string read(resultset_impl *rs, size_t index) { return rs->column_text(index); }
+    };
+
+    template<typename T>
+    struct column_reader<std::optional<T>> {
+      static std::optional<T> read(resultset_impl *rs, size_t index) {
+        if (rs->column_is_null(index)) {
+          return std::nullopt;
+        }
+        return column_reader<T>::read(rs, index);
+      }
+    };
+
+    template<typename... T, size_t... I>
+    std::tuple<T...> read_columns(resultset_impl *rs, std::index_sequence<I...>) {
+      return std::tuple<T...>{column_reader<T>::read(rs, I)...};
+    }
+  }  // namespace helper
+
+  template<typename T>
+  T column_view::as() const {
+    return helper::column_reader<T>::read(rs_, index_);
+  }
+
+  template<typename T>
+  T row_view::get(size_t index) const {
+    return helper::column_reader<T>::read(rs_, index);
+  }
+
+  /*!
+   * the results of a query read as tuples of known types.
+   * values are decoded directly to each type without creating rows, columns or values.
+   */
+  template<typename... T>
+  class typed_resultset {
+   public:
+    typedef std::tuple<T...> value_type;
+
+    /*!
+     * an iterator that reads the current row as a tuple
+     */
+    class iterator : public std::iterator<std::input_iterator_tag, value_type> {
+     private:
+      std::shared_ptr<resultset_impl> rs_;
+      bool done_;
+
+     public:
+      iterator(const std::shared_ptr<resultset_impl> &rs, bool done) : rs_(rs), done_(done) {}
+
+      value_type operator*() const { return helper::read_columns<T...>(rs_.get(), std::index_sequence_for<T...>()); }
+
+      iterator &operator++() {
+        if (!done_ && rs_ != nullptr) {
+          done_ = !rs_->advance();
+        }
+        return *this;
+      }
+
+      bool operator==(const iterator &other) const { return done_ == other.done_; }
+
+      bool operator!=(const iterator &other) const { return !operator==(other); }
+    };
+
+   private:
+    std::shared_ptr<resultset_impl> impl_;
+
+   public:
+    /*!
+     * @param impl the implementation for the results
+     */
+    explicit typed_resultset(const std::shared_ptr<resultset_impl> &impl) : impl_(impl) {
+      if (impl_ == nullptr) {
+        throw database_exception("no implementation provided for typed resultset");
+      }
+    }
+
+    /*!
+     * iteration continues from the current row.  the number of columns
+     * is checked once against the types.
+     * @return an iterator to the current row, or the first row if not started
+     * @throws no_such_column_exception if there are less columns than types
+     */
+    iterator begin() {
+      if (!impl_->is_started()) {
+        impl_->advance();
+      }
+
+      if (!impl_->has_row()) {
+        return end();
+      }
+
+      if (impl_->column_count() < sizeof...(T)) {
+        throw no_such_column_exception("expected " + std::to_string(sizeof...(T)) + " columns in results");
+      }
+
+      return iterator(impl_, false);
+    }
+
+    /*!
+     * @return an iterator to after the last row
+     */
+    iterator end() { return iterator(impl_, true); }
+  };
+
   /*!
    * the results (a set of rows) for a query
    */
@@ -197,12 +478,14 @@ namespace coda::db {
     bool is_valid() const noexcept;
 
     /*!
-     * @return an iterator to the first row
+     * iteration continues from the current row, use reset() to start again
+     * @return an iterator to the current row, or the first row if not started
      */
     iterator begin();
 
     /*!
-     * @return an immutable iterator to the first row
+     * iteration continues from the current row, use reset() to start again
+     * @return an immutable iterator to the current row, or the first row if not started
      */
     const_iterator begin() const;
 
@@ -233,12 +516,55 @@ namespace coda::db {
      */
     row_type operator*();
 
+    /*!
+     * gets a view of the current row that does not allocate a row or columns.
+     * the view is only valid until the result set moves to another row.
+     * @return the view of the current row
+     */
+    row_view view() const;
+
+    /*!
+     * gets a value in the current row converted to a type
+     * @param index the index of the column
+     * @return the converted value
+     */
+    template<typename T>
+    T get(size_t index) const {
+      return helper::column_reader<T>::read(impl_.get(), index);
+    }
+
+    /*!
+     * reads the results as tuples of the given types, one type per column
+     * @return the typed results
+     */
+    template<typename... T>
+    typed_resultset<T...> as() const {
+      return typed_resultset<T...>(impl_);
+    }
+
+    /*!
+     * reads the next rows into columns
+     * @param size the maximum number of rows to read
+     * @return the batch of rows, empty when there are no more
+     */
+    column_batch fetch_batch(size_t size) const;
+
+    /*!
+     * reads the next rows into an existing batch, reusing its storage
+     * @param batch the batch to fill
+     * @param size the maximum number of rows to read
+     * @return the number of rows read
+     */
+    size_t fetch_batch(column_batch &batch, size_t size) const;
+
     /*!
      * resets this result set back to the first row
      */
     void reset();
 
     /*!
+     * gets the number of rows.  if the backend cannot count the rows
+     * they are read and the results are reset.
      * @return the number of rows in the result set
      */
     size_t size() const;
@@ -250,10 +576,21 @@ namespace coda::db {
     bool empty() const;
 
     /*!
-     * @param funk the callback to perform for each row
+     * @param funk the callback to perform for each remaining row
      */
     void each(const std::function<void(const row_type &)> &funk) const;
 
+    /*!
+     * performs a callback for each remaining row with a view that is reused for every row
+     * @param funk the callback to perform for each row
+     */
+    void each_view(const std::function<void(const row_view &)> &funk) const;
+
+    /*!
+     * @param value true to match column names case insensitively
+     */
+    void set_ignore_case(bool value);
+
     /*!
      * @return a pointer to the implementation
      */
@@ -2,11 +2,52 @@
  * @copyright ryan jennings (coda.life), 2013
  */
 #include "row.h"
+#include "exception.h"
 
 using namespace std;
 
 namespace coda::db {
 
+  namespace {
+    /*
+     * a column of a copied row
+     */
+    class copied_column : public column_impl {
+     private:
+      shared_ptr<const vector<sql_value>> values_;
+      shared_ptr<column_index> columns_;
+      size_t index_;
+
+     public:
+      copied_column(const shared_ptr<const vector<sql_value>> &values, const shared_ptr<column_index> &columns,
+                    size_t index)
+          : values_(values), columns_(columns), index_(index) {}
+
+      bool is_valid() const override { return values_ != nullptr && index_ < values_->size(); }
+
+      sql_value to_value() const override {
+        if (!is_valid()) {
+          throw no_such_column_exception();
+        }
+        return (*values_)[index_];
+      }
+
+      string name() const override {
+        if (!is_valid() || columns_ == nullptr) {
+          return string();
+        }
+        return columns_->name(index_);
+      }
+
+      string_view to_view() const override {
+        if (!is_valid()) {
+          throw no_such_column_exception();
+        }
+        return (*values_)[index_].as_view();
+      }
+    };
+  }  // namespace
+
   row::row(const shared_ptr<row_impl> &impl) : impl_(impl) {}
 
   row::iterator row::begin() { return iterator(impl_, 0); }
@@ -51,4 +92,42 @@ namespace coda::db {
 
   shared_ptr<row_impl> row::impl() const { return impl_; }
 
+  copied_row::copied_row(const shared_ptr<const vector<sql_value>> &values, const shared_ptr<column_index> &columns)
+      : values_(values), columns_(columns) {
+    if (values_ == nullptr) {
+      throw database_exception("no values provided to copied row");
+    }
+
+    if (columns_ == nullptr) {
+      throw database_exception("no columns provided to copied row");
+    }
+  }
+
+  string copied_row::column_name(size_t position) const {
+    if (position >= size()) {
+      throw no_such_column_exception();
+    }
+    return columns_->name(position);
+  }
+
+  copied_row::column_type copied_row::column(size_t position) const {
+    if (position >= size()) {
+      throw no_such_column_exception();
+    }
+    return column_type(make_shared<copied_column>(values_, columns_, position));
+  }
+
+  copied_row::column_type copied_row::column(const string &name) const {
+    auto index = columns_->find(name);
+
+    if (index == column_index::npos) {
+      throw no_such_column_exception(name);
+    }
+    return column(index);
+  }
+
+  size_t copied_row::size() const noexcept { return values_->size(); }
+
+  bool copied_row::is_valid() const noexcept { return values_ != nullptr; }
+
 }  // namespace coda::db
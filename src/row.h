@@ -8,7 +8,9 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <vector>
 #include "column.h"
+#include "column_index.h"
 
 namespace coda::db {
   /*!
@@ -330,6 +332,37 @@ namespace coda::db {
      */
     std::shared_ptr<row_impl> impl() const;
   };
+
+  /*!
+   * a row that owns copies of its values, so it stays valid after the results move on
+   */
+  class copied_row : public row_impl {
+   private:
+    std::shared_ptr<const std::vector<sql_value>> values_;
+    std::shared_ptr<column_index> columns_;
+
+   public:
+    /*!
+     * @param values  the values of the row
+     * @param columns the names of the values
+     */
+    copied_row(const std::shared_ptr<const std::vector<sql_value>> &values,
+               const std::shared_ptr<column_index> &columns);
+
+    /* non-copyable boilerplate */
+    ~copied_row() override = default;
+    copied_row(const copied_row &other) = delete;
+    copied_row(copied_row &&other) noexcept = default;
+    copied_row &operator=(const copied_row &other) = delete;
+    copied_row &operator=(copied_row &&other) noexcept = default;
+
+    /* row_impl overrides */
+    std::string column_name(size_t position) const override;
+    column_type column(size_t position) const override;
+    column_type column(const std::string &name) const override;
+    size_t size() const noexcept override;
+    bool is_valid() const noexcept override;
+  };
 }  // namespace coda::db
 
 #endif
@@ -0,0 +1,87 @@
+/*!
+ * @copyright ryan jennings (coda.life), 2013
+ */
+#include "row_view.h"
+#include "exception.h"
+#include "resultset.h"
+#include "row.h"
+
+using namespace std;
+
+namespace coda::db {
+
+  column_view::column_view(resultset_impl *rs, size_t index) : rs_(rs), index_(index) {}
+
+  sql_value column_view::value() const { return rs_->column_value(index_); }
+
+  string column_view::name() const { return rs_->column_name(index_); }
+
+  size_t column_view::index() const noexcept { return index_; }
+
+  bool column_view::is_null() const { return rs_->column_is_null(index_); }
+
+  string_view column_view::as_view() const { return rs_->column_data(index_); }
+
+  row_view::row_view(resultset_impl *rs) : rs_(rs) {}
+
+  size_t row_view::size() const { return rs_ == nullptr ? 0 : rs_->column_count(); }
+
+  bool row_view::is_valid() const noexcept { return rs_ != nullptr; }
+
+  column_view row_view::column(size_t index) const {
+    if (index >= size()) {
+      throw no_such_column_exception();
+    }
+    return column_view(rs_, index);
+  }
+
+  column_view row_view::column(const string &name) const {
+    if (rs_ == nullptr) {
+      throw no_such_column_exception(name);
+    }
+
+    auto index = rs_->columns()->find(name);
+
+    if (index == column_index::npos) {
+      throw no_such_column_exception(name);
+    }
+
+    return column_view(rs_, index);
+  }
+
+  column_view row_view::operator[](size_t index) const { return column(index); }
+
+  column_view row_view::operator[](const string &name) const { return column(name); }
+
+  string row_view::column_name(size_t index) const {
+    if (index >= size()) {
+      throw no_such_column_exception();
+    }
+    return rs_->column_name(index);
+  }
+
+  sql_value row_view::value(size_t index) const {
+    if (index >= size()) {
+      throw no_such_column_exception();
+    }
+    return rs_->column_value(index);
+  }
+
+  row row_view::to_row() const {
+    if (rs_ == nullptr) {
+      return row();
+    }
+
+    auto count = size();
+    auto values = make_shared<vector<sql_value>>();
+
+    values->reserve(count);
+
+    // the values are copied now, a row from the result set would still read the current row
+    for (size_t i = 0; i < count; i++) {
+      values->push_back(rs_->column_value(i));
+    }
+
+    return row(make_shared<copied_row>(values, rs_->columns()));
+  }
+}  // namespace coda::db
@@ -0,0 +1,133 @@
+/*!
+ * @file row_view.h
+ * a reusable view of the current row in a result set
+ */
+#ifndef CODA_DB_ROW_VIEW_H
+#define CODA_DB_ROW_VIEW_H
+
+#include <string>
+#include <string_view>
+#include "sql_value.h"
+
+namespace coda::db {
+  class resultset_impl;
+  class row;
+
+  /*!
+   * a view of a column in the current row of a result set.
+   * only valid until the result set moves to another row.
+   */
+  class column_view {
+   private:
+    resultset_impl *rs_;
+    size_t index_;
+
+   public:
+    /*!
+     * @param rs    the result set
+     * @param index the index of the column
+     */
+    column_view(resultset_impl *rs, size_t index);
+
+    /*!
+     * @return the value of the column
+     */
+    sql_value value() const;
+
+    /*!
+     * @return the name of the column
+     */
+    std::string name() const;
+
+    /*!
+     * @return the index of the column
+     */
+    size_t index() const noexcept;
+
+    /*!
+     * @return true if the value is null
+     */
+    bool is_null() const;
+
+    /*!
+     * @return a view of a text or blob value, only valid until the result set moves
+     */
+    std::string_view as_view() const;
+
+    /*!
+     * @return the value converted to a type, defined in resultset.h
+     */
+    template<typename T>
+    T as() const;
+  };
+
+  /*!
+   * a view of the current row in a result set that reads values directly
+   * from the results without creating row or column objects.
+   * only valid until the result set moves to another row, use to_row() to keep a copy.
+   */
+  class row_view {
+   private:
+    resultset_impl *rs_;
+
+   public:
+    /*!
+     * @param rs the result set
+     */
+    explicit row_view(resultset_impl *rs);
+
+    /*!
+     * @return the number of columns
+     */
+    size_t size() const;
+
+    /*!
+     * @return true if the view has a result set
+     */
+    bool is_valid() const noexcept;
+
+    /*!
+     * @param index the index of the column
+     * @return a view of the column
+     */
+    column_view column(size_t index) const;
+
+    /*!
+     * @param name the name of the column
+     * @return a view of the column
+     * @throws no_such_column_exception if the column was not found
+     */
+    column_view column(const std::string &name) const;
+
+    column_view operator[](size_t index) const;
+
+    column_view operator[](const std::string &name) const;
+
+    /*!
+     * @param index the index of the column
+     * @return the name of the column
+     */
+    std::string column_name(size_t index) const;
+
+    /*!
+     * @param index the index of the column
+     * @return the value of the column
+     */
+    sql_value value(size_t index) const;
+
+    /*!
+     * gets a value converted to a type, defined in resultset.h
+     * @param index the index of the column
+     * @return the converted value
+     */
+    template<typename T>
+    T get(size_t index) const;
+
+    /*!
+     * @return a row that can be kept after the result set moves
+     */
+    row to_row() const;
+  };
+}  // namespace coda::db
+
+#endif
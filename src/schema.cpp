@@ -1,5 +1,6 @@
 
 #include "schema.h"
+#include "column_index.h"
 #include "exception.h"
 #include "resultset.h"
 #include "session.h"
@@ -32,8 +33,12 @@ namespace coda::db {
     }
 
     columns_ = session_->get_columns_for_schema(tableName_);
+
+    index_ = std::make_shared<column_index>(column_names());
   }
 
+  std::shared_ptr<column_index> schema::index() const noexcept { return index_; }
+
   vector<column_definition> schema::columns() const noexcept { return columns_; }
 
   vector<string> schema::column_names() const {
@@ -14,6 +14,8 @@ namespace coda::db {
 
   class sql_value;
 
+  class column_index;
+
   /*!
    * Definition of a column in a schema
    */
@@ -42,6 +44,7 @@ namespace coda::db {
     std::shared_ptr<session_type> session_;
     std::string tableName_;
     std::vector<column_definition> columns_;
+    std::shared_ptr<column_index> index_;
 
    public:
     /*!
@@ -76,6 +79,12 @@ namespace coda::db {
      */
     std::vector<std::string> column_names() const;
 
+    /*!
+     * the column ordinals shared by records of this schema
+     * @return the column index, or nullptr before the schema is initialized
+     */
+    std::shared_ptr<column_index> index() const noexcept;
+
     /*!
      * @return the primary keys for this schema
      */
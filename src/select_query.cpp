@@ -169,17 +169,21 @@ namespace coda::db {
     try {
       columns_ = {"COUNT(*)"};
 
-      prepare(to_sql());
+      set_modified();
 
       auto value = execute_scalar<sql_number>();
 
       columns_ = cols;
 
+      set_modified();
+
       return value.as<long long>();
     } catch (...) {
       // make sure we don't leave this query in a temp state
       columns_ = cols;
 
+      set_modified();
+
       return -1;
     }
   }
@@ -35,9 +35,17 @@ namespace coda::db {
 
   bool session::is_open() const noexcept { return impl_->is_open(); }
 
-  void session::open() { return impl_->open(); }
+  void session::open() {
+    // statements of a previous connection are not reused
+    statements_.invalidate();
+    return impl_->open();
+  }
 
-  void session::close() { return impl_->close(); }
+  void session::close() {
+    // cached statements must be finished before the connection goes away
+    statements_.invalidate();
+    return impl_->close();
+  }
 
   sql_id session::last_insert_id() const { return impl_->last_insert_id(); }
 
@@ -51,6 +59,12 @@ namespace coda::db {
     return stmt;
   }
 
+  std::shared_ptr<session::statement_type> session::prepare_statement(const std::string &sql) {
+    return statements_.get(sql, [this](const std::string &value) { return create_statement(value); });
+  }
+
+  statement_cache &session::statements() { return statements_; }
+
   session::transaction_type session::create_transaction() {
     return session::transaction_type(shared_from_this(), impl_->create_transaction());
   }
@@ -63,10 +77,19 @@ namespace coda::db {
 
   int session_impl::features() const { return 0; }
 
+  // the lowest common limit (older sqlite versions)
+  size_t session_impl::max_bind_params() const { return 999; }
+
+  bool session_impl::in_transaction() const noexcept { return false; }
+
   shared_ptr<session_impl> session::impl() const { return impl_; }
 
   bool session::has_feature(feature_type feature) const { return (impl_->features() & feature) != 0; }
 
+  size_t session::max_bind_params() const { return impl_->max_bind_params(); }
+
+  bool session::in_transaction() const noexcept { return impl_->in_transaction(); }
+
   /*!
    * utility method used in creating sql
    */
@@ -9,6 +9,7 @@
 #include <memory>
 #include <vector>
 #include "schema_factory.h"
+#include "statement_cache.h"
 #include "uri.h"
 #include "sql_types.h"
 
@@ -117,6 +118,18 @@ namespace coda::db {
 
     virtual int features() const;
 
+    /*!
+     * gets the maximum number of parameters a single statement should bind
+     * @return the parameter limit
+     */
+    virtual size_t max_bind_params() const;
+
+    /*!
+     * tests if the connection is inside a transaction, however it was started
+     * @return true if a transaction is open
+     */
+    virtual bool in_transaction() const noexcept;
+
    private:
     uri connectionInfo_;
   };
@@ -179,6 +192,19 @@ namespace coda::db {
      */
     std::shared_ptr<statement_type> create_statement(const std::string &sql = "");
 
+    /*!
+     * gets a prepared statement from the statement cache, preparing one if needed
+     * @param sql the sql to prepare
+     * @return a reset statement ready for binding
+     */
+    std::shared_ptr<statement_type> prepare_statement(const std::string &sql);
+
+    /*!
+     * gets the prepared statement cache for this session
+     * @return the statement cache
+     */
+    statement_cache &statements();
+
     /*!
      * creates a transaction, but won't start it yet
      * @return the created transaction object
@@ -233,6 +259,18 @@ namespace coda::db {
      */
     std::string join_params(const std::vector<std::string> &columns, const std::string &op = "") const;
 
+    /*!
+     * gets the maximum number of parameters a single statement should bind
+     * @return the parameter limit
+     */
+    size_t max_bind_params() const;
+
+    /*!
+     * tests if the connection is inside a transaction, however it was started
+     * @return true if a transaction is open
+     */
+    bool in_transaction() const noexcept;
+
    private:
     std::shared_ptr<session_impl> impl_;
 
@@ -250,12 +288,16 @@ namespace coda::db {
 
     schema_factory schema_factory_;
 
+    statement_cache statements_;
+
    public:
     typedef enum {
       FEATURE_RETURNING = (1 << 0),
       FEATURE_FULL_OUTER_JOIN = (1 << 1),
       FEATURE_RIGHT_JOIN = (1 << 2),
-      FEATURE_NAMED_PARAMS = (1 << 3)
+      FEATURE_NAMED_PARAMS = (1 << 3),
+      FEATURE_ON_CONFLICT = (1 << 4),
+      FEATURE_ON_DUPLICATE_KEY = (1 << 5)
     } feature_type;
 
     bool has_feature(feature_type feature) const;
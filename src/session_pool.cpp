@@ -0,0 +1,295 @@
+/*!
+ * @copyright ryan jennings (coda.life), 2013
+ */
+#include "session_pool.h"
+#include <algorithm>
+#include <vector>
+#include "exception.h"
+#include "session.h"
+#include "sqldb.h"
+
+namespace coda::db {
+
+  session_pool::handle::handle(const std::shared_ptr<session_pool> &pool, const std::shared_ptr<session> &value)
+      : pool_(pool), session_(value), valid_(true) {}
+
+  session_pool::handle::handle(handle &&other) noexcept
+      : pool_(std::move(other.pool_)), session_(std::move(other.session_)), valid_(other.valid_) {
+    other.session_ = nullptr;
+  }
+
+  session_pool::handle::~handle() {
+    try {
+      release();
+    } catch (...) {
+      // never throw from a destructor
+    }
+  }
+
+  session_pool::handle &session_pool::handle::operator=(handle &&other) noexcept {
+    if (this != &other) {
+      try {
+        release();
+      } catch (...) {
+      }
+      pool_ = std::move(other.pool_);
+      session_ = std::move(other.session_);
+      valid_ = other.valid_;
+      other.session_ = nullptr;
+    }
+    return *this;
+  }
+
+  std::shared_ptr<session> session_pool::handle::get() const noexcept { return session_; }
+
+  session *session_pool::handle::operator->() const noexcept { return session_.get(); }
+
+  session &session_pool::handle::operator*() const noexcept { return *session_; }
+
+  session_pool::handle::operator bool() const noexcept { return session_ != nullptr; }
+
+  void session_pool::handle::release() {
+    if (session_ == nullptr) {
+      return;
+    }
+
+    auto value = std::move(session_);
+    session_ = nullptr;
+
+    auto pool = pool_.lock();
+
+    if (pool) {
+      pool->put_back(value, valid_);
+    }
+  }
+
+  void session_pool::handle::invalidate() noexcept { valid_ = false; }
+
+  session_pool::session_pool(const uri &info, const options &opts)
+      : info_(info), options_(opts), next_ticket_(0), size_(0) {
+    if (options_.max_size == 0) {
+      throw database_exception("session pool maximum size must be greater than zero");
+    }
+
+    if (options_.min_size > options_.max_size) {
+      throw database_exception("session pool minimum size is greater than the maximum size");
+    }
+  }
+
+  session_pool::session_pool(const std::string &info, const options &opts) : session_pool(uri(info), opts) {}
+
+  session_pool::~session_pool() { clear(); }
+
+  uri session_pool::connection_info() const { return info_; }
+
+  size_t session_pool::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+  }
+
+  size_t session_pool::idle_size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idle_.size();
+  }
+
+  size_t session_pool::in_use() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_ - idle_.size();
+  }
+
+  std::shared_ptr<session> session_pool::open_one() { return open_session(info_); }
+
+  bool session_pool::validate(const std::shared_ptr<session> &value) const {
+    try {
+      if (!value->is_open()) {
+        return false;
+      }
+      return !options_.validator || options_.validator(value);
+    } catch (...) {
+      return false;
+    }
+  }
+
+  void session_pool::discard(const std::shared_ptr<session> &value) noexcept {
+    try {
+      value->close();
+    } catch (...) {
+    }
+  }
+
+  void session_pool::fill() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (size_ < options_.min_size) {
+      size_++;
+
+      lock.unlock();
+
+      std::shared_ptr<session> value;
+
+      try {
+        value = open_one();
+      } catch (...) {
+        lock.lock();
+        size_--;
+        available_.notify_all();
+        throw;
+      }
+
+      lock.lock();
+
+      idle_.push_back({value, clock_type::now()});
+
+      available_.notify_all();
+    }
+  }
+
+  session_pool::handle session_pool::acquire() { return acquire(options_.wait_timeout); }
+
+  session_pool::handle session_pool::acquire(const duration_type &timeout) {
+    auto deadline = clock_type::now() + timeout;
+
+    // pools are shared so handles can find their way back
+    auto self = shared_from_this();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    evict_idle(lock);
+
+    auto ticket = next_ticket_++;
+
+    waiters_.push_back(ticket);
+
+    for (;;) {
+      auto ready = [&]() {
+        return waiters_.front() == ticket && (!idle_.empty() || size_ < options_.max_size);
+      };
+
+      if (!available_.wait_until(lock, deadline, ready)) {
+        waiters_.erase(std::find(waiters_.begin(), waiters_.end(), ticket));
+        // the next waiter may now be at the front
+        available_.notify_all();
+        throw database_exception("timed out waiting for a pooled session");
+      }
+
+      waiters_.pop_front();
+
+      if (!idle_.empty()) {
+        // most recently used first, so older sessions can age out
+        auto value = idle_.back().value;
+        idle_.pop_back();
+
+        available_.notify_all();
+
+        lock.unlock();
+
+        if (validate(value)) {
+          return handle(self, value);
+        }
+
+        discard(value);
+
+        lock.lock();
+
+        size_--;
+
+        // keep our place in line and try again
+        waiters_.push_front(ticket);
+        continue;
+      }
+
+      size_++;
+
+      available_.notify_all();
+
+      lock.unlock();
+
+      try {
+        return handle(self, open_one());
+      } catch (...) {
+        lock.lock();
+        size_--;
+        available_.notify_all();
+        throw;
+      }
+    }
+  }
+
+  void session_pool::put_back(const std::shared_ptr<session> &value, bool valid) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (!valid || !value->is_open()) {
+      size_--;
+      available_.notify_all();
+      lock.unlock();
+      discard(value);
+      return;
+    }
+
+    idle_.push_back({value, clock_type::now()});
+
+    available_.notify_all();
+
+    evict_idle(lock);
+  }
+
+  size_t session_pool::evict_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return evict_idle(lock);
+  }
+
+  size_t session_pool::evict_idle(std::unique_lock<std::mutex> &lock) {
+    if (options_.idle_timeout.count() <= 0) {
+      return 0;
+    }
+
+    auto expired = clock_type::now() - options_.idle_timeout;
+
+    std::vector<std::shared_ptr<session>> evicted;
+
+    // idle sessions are ordered oldest first
+    while (!idle_.empty() && size_ > options_.min_size && idle_.front().since <= expired) {
+      evicted.push_back(idle_.front().value);
+      idle_.pop_front();
+      size_--;
+    }
+
+    if (evicted.empty()) {
+      return 0;
+    }
+
+    available_.notify_all();
+
+    lock.unlock();
+
+    for (const auto &value : evicted) {
+      discard(value);
+    }
+
+    lock.lock();
+
+    return evicted.size();
+  }
+
+  void session_pool::clear() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    std::vector<std::shared_ptr<session>> evicted;
+
+    for (const auto &entry : idle_) {
+      evicted.push_back(entry.value);
+    }
+
+    size_ -= idle_.size();
+
+    idle_.clear();
+
+    available_.notify_all();
+
+    lock.unlock();
+
+    for (const auto &value : evicted) {
+      discard(value);
+    }
+  }
+}  // namespace coda::db
@@ -0,0 +1,198 @@
+/*!
+ * @file session_pool.h
+ * a thread safe pool of database sessions
+ * @copyright ryan jennings (coda.life), 2013
+ */
+#ifndef CODA_DB_SESSION_POOL_H
+#define CODA_DB_SESSION_POOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include "uri.h"
+
+namespace coda::db {
+  class session;
+
+  /*!
+   * tuning options for a session pool
+   */
+  struct session_pool_options {
+    using duration_type = std::chrono::milliseconds;
+    using validator_type = std::function<bool(const std::shared_ptr<session> &)>;
+
+    /*! the number of sessions to keep open, even when idle */
+    size_t min_size = 0;
+    /*! the maximum number of open sessions */
+    size_t max_size = 10;
+    /*! how long acquire() waits for a session before throwing */
+    duration_type wait_timeout = std::chrono::seconds(30);
+    /*! how long an idle session is kept above the minimum size, zero to never evict */
+    duration_type idle_timeout = std::chrono::minutes(5);
+    /*! an optional health check performed on checkout */
+    validator_type validator;
+  };
+
+  /*!
+   * A pool of open sessions for a single uri.
+   * Sessions are checked out with acquire() and are returned to the pool
+   * when the handle goes out of scope.  Waiters are served in the order
+   * they arrived.  A pool must be owned by a std::shared_ptr.
+   */
+  class session_pool : public std::enable_shared_from_this<session_pool> {
+   public:
+    using clock_type = std::chrono::steady_clock;
+    using duration_type = session_pool_options::duration_type;
+
+    using options = session_pool_options;
+
+    /*!
+     * a checked out session, returned to the pool on destruction
+     */
+    class handle {
+      friend class session_pool;
+
+     public:
+      handle() = default;
+
+      handle(const handle &other) = delete;
+
+      handle(handle &&other) noexcept;
+
+      ~handle();
+
+      handle &operator=(const handle &other) = delete;
+
+      handle &operator=(handle &&other) noexcept;
+
+      /*!
+       * @return the checked out session
+       */
+      std::shared_ptr<session> get() const noexcept;
+
+      session *operator->() const noexcept;
+
+      session &operator*() const noexcept;
+
+      explicit operator bool() const noexcept;
+
+      /*!
+       * returns the session to the pool early
+       */
+      void release();
+
+      /*!
+       * marks the session as broken so it is closed instead of returned to the pool
+       */
+      void invalidate() noexcept;
+
+     private:
+      handle(const std::shared_ptr<session_pool> &pool, const std::shared_ptr<session> &value);
+
+      std::weak_ptr<session_pool> pool_;
+      std::shared_ptr<session> session_;
+      bool valid_ = true;
+    };
+
+    /*!
+     * @param info    the uri used to create sessions
+     * @param opts    the pool options
+     */
+    explicit session_pool(const uri &info, const options &opts = options());
+
+    /*!
+     * @param info    the uri string used to create sessions
+     * @param opts    the pool options
+     */
+    explicit session_pool(const std::string &info, const options &opts = options());
+
+    /* non-copyable boilerplate */
+    session_pool(const session_pool &other) = delete;
+
+    session_pool(session_pool &&other) = delete;
+
+    ~session_pool();
+
+    session_pool &operator=(const session_pool &other) = delete;
+
+    session_pool &operator=(session_pool &&other) = delete;
+
+    /*!
+     * opens sessions until the minimum size is reached
+     */
+    void fill();
+
+    /*!
+     * checks out a session, waiting up to the configured timeout
+     * @return the session handle
+     * @throws database_exception if no session became available in time
+     */
+    handle acquire();
+
+    /*!
+     * checks out a session
+     * @param timeout the maximum time to wait
+     * @return the session handle
+     * @throws database_exception if no session became available in time
+     */
+    handle acquire(const duration_type &timeout);
+
+    /*!
+     * closes idle sessions past the idle timeout, keeping the minimum size
+     * @return the number of sessions closed
+     */
+    size_t evict_idle();
+
+    /*!
+     * closes all idle sessions
+     */
+    void clear();
+
+    /*!
+     * @return the number of open sessions, idle or checked out
+     */
+    size_t size() const;
+
+    /*!
+     * @return the number of idle sessions
+     */
+    size_t idle_size() const;
+
+    /*!
+     * @return the number of checked out sessions
+     */
+    size_t in_use() const;
+
+    /*!
+     * @return the uri used to create sessions
+     */
+    uri connection_info() const;
+
+   private:
+    struct idle_session {
+      std::shared_ptr<session> value;
+      clock_type::time_point since;
+    };
+
+    std::shared_ptr<session> open_one();
+    bool validate(const std::shared_ptr<session> &value) const;
+    void put_back(const std::shared_ptr<session> &value, bool valid);
+    void discard(const std::shared_ptr<session> &value) noexcept;
+    size_t evict_idle(std::unique_lock<std::mutex> &lock);
+
+    uri info_;
+    options options_;
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::deque<idle_session> idle_;
+    std::deque<uint64_t> waiters_;
+    uint64_t next_ticket_;
+    size_t size_;
+  };
+}  // namespace coda::db
+
+#endif
@@ -1,7 +1,6 @@
 #include "sql_common.h"
-#include <codecvt>
-#include <locale>
 #include "sql_number.h"
+#include "unicode.h"
 
 namespace coda::db {
   std::ostream &operator<<(std::ostream &out, const sql_blob &value) {
@@ -76,13 +75,9 @@ namespace coda::db {
       return equals(value, L"false") || equals(value, L"no") || value == L"0";
     }
 
-    std::string convert_string(const std::wstring &buf) {
-      typedef std::codecvt_utf8<wchar_t> convert_type;
-      std::wstring_convert<convert_type, wchar_t> converter;
-      return converter.to_bytes(buf);
-    }
+    std::string convert_string(const std::wstring &buf) { return to_utf8(buf); }
 
-    std::wstring convert_string(const std::string &buf) { return std::wstring(buf.begin(), buf.end()); }
+    std::wstring convert_string(const std::string &buf) { return utf8_to_wide(buf); }
 
     sql_string as_sql_string::operator()(const sql_time &value) const { return value.to_string(); }
 
@@ -6,6 +6,7 @@
 #include <string>
 #include <type_traits>
 #include <vector>
+#include "number_format.h"
 #include "sql_types.h"
 
 namespace coda::db {
@@ -119,7 +120,7 @@ namespace coda::db {
      public:
       template<typename V>
       sql_string operator()(const V &value) const {
-        return std::to_string(value);
+        return format_number(value);
       }
 
       sql_string operator()(const sql_time &value) const;
@@ -139,7 +140,8 @@ namespace coda::db {
      public:
       template<typename V>
       sql_wstring operator()(const V &value) const {
-        return std::to_wstring(value);
+        auto str = format_number(value);
+        return sql_wstring(str.begin(), str.end());
       }
 
       sql_wstring operator()(const sql_time &value) const;
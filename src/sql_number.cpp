@@ -1,4 +1,5 @@
 #include "sql_number.h"
+#include "number_format.h"
 
 namespace coda::db {
   sql_number::sql_number() : value_(0) {}
@@ -49,6 +50,64 @@ namespace coda::db {
 
   sql_number::sql_number(const sql_null_type &value) : value_(value) {}
 
+  bool sql_number::parse_digits(const sql_string &value) {
+    if (value.find_first_of(".eE") == std::string::npos) {
+      int i;
+      long l;
+      unsigned long ul;
+      long long ll;
+      unsigned long long ull;
+
+      if (helper::parse_number(value, i)) {
+        value_ = i;
+      } else if (helper::parse_number(value, l)) {
+        value_ = l;
+      } else if (helper::parse_number(value, ul)) {
+        value_ = ul;
+      } else if (helper::parse_number(value, ll)) {
+        value_ = ll;
+      } else if (helper::parse_number(value, ull)) {
+        value_ = ull;
+      } else {
+        return false;
+      }
+      return true;
+    }
+
+    double d;
+    long double ld;
+
+    if (helper::parse_number(value, d)) {
+      // keep the smaller type when no precision is lost
+      auto f = static_cast<float>(d);
+      if (static_cast<double>(f) == d) {
+        value_ = f;
+      } else {
+        value_ = d;
+      }
+    } else if (helper::parse_number(value, ld)) {
+      value_ = ld;
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  bool sql_number::parse_digits(const sql_wstring &value) {
+    sql_string narrow;
+
+    narrow.reserve(value.size());
+
+    for (auto ch : value) {
+      // numbers are only ever ascii
+      if (ch < 0 || ch > 0x7F) {
+        return false;
+      }
+      narrow.push_back(static_cast<char>(ch));
+    }
+    return parse_digits(narrow);
+  }
+
   template<>
   sql_string sql_number::as() const {
     return std::visit(helper::as_sql_string(), value_);
@@ -141,13 +141,7 @@ namespace coda::db {
       if (!std::any_of(value.begin(), value.end(), ::isdigit)) {
         return parse_bool(value);
       }
-      if (value.find('.') != std::string::npos) {
-        return parse_floating<float>(value, std::stof) || parse_floating<double>(value, std::stod) ||
-            parse_floating<long double>(value, std::stold);
-      }
-      return parse_integral<int>(value, std::stoi) || parse_integral<long>(value, std::stol) ||
-          parse_integral<unsigned long>(value, std::stoul) || parse_integral<long long>(value, std::stoll) ||
-          parse_integral<unsigned long long>(value, std::stoull);
+      return parse_digits(value);
     }
 
     template<typename V, typename T>
@@ -202,29 +196,9 @@ namespace coda::db {
     bool operator==(const long double &value) const override;
 
    private:
-    constexpr static const int BASE10 = 10;
-
-    template<typename T, typename S>
-    typename std::enable_if<std::is_integral<T>::value && is_sql_string<S>::value, bool>::type parse_integral(
-        const S &value, T (*funk)(const S &, size_t *, int), int base = BASE10) {
-      try {
-        value_ = funk(value, nullptr, base);
-        return true;
-      } catch (const std::exception &e) {
-        return false;
-      }
-    }
+    bool parse_digits(const sql_string &value);
 
-    template<typename T, typename S>
-    typename std::enable_if<std::is_floating_point<T>::value && is_sql_string<S>::value, bool>::type parse_floating(
-        const S &value, T (*funk)(const S &, size_t *)) {
-      try {
-        value_ = funk(value, nullptr);
-        return true;
-      } catch (const std::exception &e) {
-        return false;
-      }
-    }
+    bool parse_digits(const sql_wstring &value);
 
     template<typename S, typename = std::enable_if<is_sql_string<S>::value>>
     bool parse_bool(const S &value) {
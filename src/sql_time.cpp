@@ -1,66 +1,396 @@
 #include "sql_time.h"
+#include <algorithm>
+#include <cctype>
 #include <cstring>
 #include "exception.h"
+#include "number_format.h"
 #include "sql_number.h"
 
 namespace coda::db {
-  bool sql_time::parse(const std::string &value) {
-    struct tm tp{};
+  namespace {
+    constexpr static const long long MICROS_PER_SECOND = 1000000LL;
+    constexpr static const long long MICROS_PER_DAY = 86400LL * MICROS_PER_SECOND;
+    // times closer to the epoch are elapsed times, which a mysql TIME keeps up to 838:59:59
+    constexpr static const long long MAX_ELAPSED_TIME = 840LL * 3600LL * MICROS_PER_SECOND;
 
-    if (value.length() == 0) {
-      return false;
+    long long floor_div(long long value, long long divisor) noexcept {
+      auto result = value / divisor;
+      return (value % divisor != 0 && value < 0) ? result - 1 : result;
     }
 
-    memset(&tp, 0, sizeof(tp));
+    /**
+     * the days since the unix epoch of a proleptic gregorian date
+     */
+    long long days_from_civil(long long year, unsigned month, unsigned day) noexcept {
+      year -= month <= 2;
+      auto era = (year >= 0 ? year : year - 399) / 400;
+      auto yoe = static_cast<unsigned>(year - era * 400);
+      auto doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+      auto doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+      return era * 146097 + static_cast<long long>(doe) - 719468;
+    }
 
-    if (strptime(value.c_str(), "%Y-%m-%d %H:%M:%S", &tp)) {
-      value_ = timegm(&tp);
-      format_ = DATETIME;
-      return true;
+    /**
+     * the proleptic gregorian date of the days since the unix epoch
+     */
+    void civil_from_days(long long days, long long &year, unsigned &month, unsigned &day) noexcept {
+      days += 719468;
+      auto era = (days >= 0 ? days : days - 146096) / 146097;
+      auto doe = static_cast<unsigned>(days - era * 146097);
+      auto yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+      auto doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+      auto mp = (5 * doy + 2) / 153;
+      day = doy - (153 * mp + 2) / 5 + 1;
+      month = mp < 10 ? mp + 3 : mp - 9;
+      year = static_cast<long long>(yoe) + era * 400 + (month <= 2);
     }
 
-    if (strptime(value.c_str(), "%Y-%m-%d", &tp)) {
-      value_ = timegm(&tp);
-      format_ = DATE;
-      return true;
+    unsigned days_in_month(long long year, unsigned month) noexcept {
+      static const unsigned char days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+      if (month == 2 && year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) {
+        return 29;
+      }
+      return days[month - 1];
     }
 
-    if (strptime(value.c_str(), "%H:%M:%S", &tp)) {
-      /* set date to 1970-1-1 */
-      tp.tm_year = 70;
-      tp.tm_mon = 0;
-      tp.tm_mday = 1;
-      value_ = timegm(&tp);
-      format_ = TIME;
-      return true;
+    char *write_digits(char *out, unsigned long value, int width) noexcept {
+      for (int i = width - 1; i >= 0; i--) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+      }
+      return out + width;
+    }
+
+    /**
+     * a cursor over the text of a time
+     */
+    class time_reader {
+     public:
+      time_reader(const char *first, const char *last) : pos_(first), end_(last) {}
+
+      bool done() const noexcept { return pos_ == end_; }
+
+      bool peek(char value) const noexcept { return pos_ < end_ && *pos_ == value; }
+
+      bool skip(char value) noexcept {
+        if (!peek(value)) {
+          return false;
+        }
+        pos_++;
+        return true;
+      }
+
+      size_t digits() const noexcept {
+        auto it = pos_;
+        while (it < end_ && isdigit(static_cast<unsigned char>(*it))) {
+          it++;
+        }
+        return static_cast<size_t>(it - pos_);
+      }
+
+      bool read(size_t count, unsigned long &value) noexcept {
+        if (count == 0 || digits() < count) {
+          return false;
+        }
+        unsigned long result = 0;
+        for (size_t i = 0; i < count; i++) {
+          result = result * 10 + static_cast<unsigned long>(pos_[i] - '0');
+        }
+        pos_ += count;
+        value = result;
+        return true;
+      }
+
+      bool read(size_t count, unsigned &value) noexcept {
+        unsigned long result = 0;
+        if (!read(count, result)) {
+          return false;
+        }
+        value = static_cast<unsigned>(result);
+        return true;
+      }
+
+      /**
+       * reads "YYYY-MM-DD" as days since the epoch
+       */
+      bool read_date(long long &days) noexcept {
+        unsigned long year = 0;
+        unsigned month = 0, day = 0;
+
+        if (digits() < 4 || digits() > 9 || !read(digits(), year) || !skip('-') || !read(2, month) || !skip('-') ||
+            !read(2, day)) {
+          return false;
+        }
+        // the mysql zero date
+        if (year == 0 && month == 0 && day == 0) {
+          days = 0;
+          return true;
+        }
+        if (month < 1 || month > 12 || day < 1 || day > days_in_month(static_cast<long long>(year), month)) {
+          return false;
+        }
+        days = days_from_civil(static_cast<long long>(year), month, day);
+        return true;
+      }
+
+      /**
+       * reads "HH:MM[:SS[.ffffff]]" as microseconds, with up to the given number of hour digits
+       */
+      bool read_clock(size_t hour_digits, unsigned &hour, long long &micros) noexcept {
+        unsigned minute = 0, second = 0;
+        unsigned long fraction = 0;
+        auto hour_count = digits();
+
+        if (hour_count < 2 || hour_count > hour_digits || !read(hour_count, hour) || !skip(':') || !read(2, minute)) {
+          return false;
+        }
+        if (skip(':')) {
+          if (!read(2, second)) {
+            return false;
+          }
+          if (skip('.') || skip(',')) {
+            auto count = digits();
+            if (!read(std::min<size_t>(count, 6), fraction)) {
+              return false;
+            }
+            for (auto i = count; i < 6; i++) {
+              fraction *= 10;
+            }
+            // precision past microseconds is truncated
+            pos_ += count > 6 ? count - 6 : 0;
+          }
+        }
+        if (minute > 59 || second > 59) {
+          return false;
+        }
+        micros = (hour * 3600LL + minute * 60LL + second) * MICROS_PER_SECOND + static_cast<long long>(fraction);
+        return true;
+      }
+
+      /**
+       * reads a signed "[-]HHH:MM:SS[.ffffff]" elapsed time, which a mysql TIME keeps up to 838:59:59
+       */
+      bool read_elapsed(long long &micros) noexcept {
+        auto negative = skip('-');
+        unsigned hour = 0;
+
+        if (!read_clock(3, hour, micros) || hour > 838) {
+          return false;
+        }
+        micros = negative ? -micros : micros;
+        return true;
+      }
+
+      /**
+       * reads "HH:MM[:SS[.ffffff]]" with an optional zone as microseconds past midnight in UTC
+       */
+      bool read_time(long long &micros) noexcept {
+        unsigned hour = 0;
+
+        // end of day and leap seconds can not be kept, so they are not read as the next day
+        if (!read_clock(2, hour, micros) || hour > 23) {
+          return false;
+        }
+
+        if (skip('Z')) {
+          return true;
+        }
+        auto sign = peek('-') ? -1 : 1;
+        if (skip('+') || skip('-')) {
+          unsigned offset_hour = 0, offset_minute = 0;
+          if (!read(2, offset_hour)) {
+            return false;
+          }
+          skip(':');
+          if (digits() > 0 && !read(2, offset_minute)) {
+            return false;
+          }
+          if (offset_hour > 23 || offset_minute > 59) {
+            return false;
+          }
+          micros -= sign * (offset_hour * 3600LL + offset_minute * 60LL) * MICROS_PER_SECOND;
+        }
+        return true;
+      }
+
+     private:
+      const char *pos_;
+      const char *end_;
+    };
+  }  // namespace
+
+  bool sql_time::parse(std::string_view value) noexcept {
+    auto first = value.data();
+    auto last = first + value.size();
+
+    while (first < last && isspace(static_cast<unsigned char>(*first))) {
+      first++;
     }
+    while (last > first && isspace(static_cast<unsigned char>(*(last - 1)))) {
+      last--;
+    }
+    if (first == last) {
+      return false;
+    }
+
+    long long seconds = 0;
 
-    try {
-      value_ = std::stoul(value);
+    if (helper::parse_number(std::string_view(first, static_cast<size_t>(last - first)), seconds)) {
+      value_ = time_point(std::chrono::seconds(seconds));
       format_ = TIMESTAMP;
       return true;
-    } catch (...) {
+    }
+
+    time_reader reader(first, last);
+    long long days = 0, micros = 0;
+    formats format = TIME;
+
+    if (reader.digits() >= 4) {
+      if (!reader.read_date(days)) {
+        return false;
+      }
+      format = DATE;
+
+      if (!reader.done()) {
+        if (!(reader.skip(' ') || reader.skip('T')) || !reader.read_time(micros)) {
+          return false;
+        }
+        format = DATETIME;
+      }
+    } else {
+      time_reader clock = reader;
+
+      if (clock.read_time(micros)) {
+        // a time of day, shifted by a zone, stays on the same day
+        micros = ((micros % MICROS_PER_DAY) + MICROS_PER_DAY) % MICROS_PER_DAY;
+        reader = clock;
+      } else if (!reader.read_elapsed(micros)) {
+        return false;
+      }
+    }
+
+    if (!reader.done()) {
       return false;
     }
+
+    value_ = time_point(std::chrono::microseconds(days * MICROS_PER_DAY + micros));
+    format_ = format;
+    return true;
+  }
+
+  char *sql_time::to_chars(char *first, char *last) const noexcept {
+    char buf[BUFFER_SIZE];
+    auto out = buf;
+    auto micros = value_.time_since_epoch().count();
+    auto days = floor_div(micros, MICROS_PER_DAY);
+    auto of_day = micros - days * MICROS_PER_DAY;
+
+    if (format_ != TIME) {
+      long long year = 0;
+      unsigned month = 0, day = 0;
+
+      civil_from_days(days, year, month, day);
+
+      if (year < 0) {
+        *out++ = '-';
+        year = -year;
+      }
+      if (year > 9999) {
+        out = helper::format_number(out, buf + sizeof(buf), year);
+      } else {
+        out = write_digits(out, static_cast<unsigned long>(year), 4);
+      }
+      *out++ = '-';
+      out = write_digits(out, month, 2);
+      *out++ = '-';
+      out = write_digits(out, day, 2);
+    }
+
+    if (format_ != DATE) {
+      if (format_ != TIME) {
+        *out++ = ' ';
+      }
+      auto elapsed = format_ == TIME && micros > -MAX_ELAPSED_TIME && micros < MAX_ELAPSED_TIME;
+      auto clock = elapsed ? micros : of_day;
+
+      if (clock < 0) {
+        *out++ = '-';
+        clock = -clock;
+      }
+      auto seconds = clock / MICROS_PER_SECOND;
+      auto fraction = static_cast<unsigned long>(clock % MICROS_PER_SECOND);
+      auto hours = static_cast<unsigned long>(seconds / 3600);
+
+      out = write_digits(out, hours, hours > 99 ? 3 : 2);
+      *out++ = ':';
+      out = write_digits(out, static_cast<unsigned long>(seconds / 60 % 60), 2);
+      *out++ = ':';
+      out = write_digits(out, static_cast<unsigned long>(seconds % 60), 2);
+
+      if (fraction != 0) {
+        *out++ = '.';
+        out = write_digits(out, fraction, 6);
+        while (*(out - 1) == '0') {
+          out--;
+        }
+      }
+    }
+
+    auto size = static_cast<size_t>(out - buf);
+
+    if (static_cast<size_t>(last - first) < size) {
+      return nullptr;
+    }
+    memcpy(first, buf, size);
+    return first + size;
   }
 
-  sql_time::sql_time(time_t value, formats format) : value_(value), format_(format) {}
+  sql_time::sql_time(time_t value, formats format)
+      : value_(time_point(std::chrono::seconds(value))), format_(format) {}
+
+  sql_time::sql_time(const time_point &value, formats format) : value_(value), format_(format) {}
 
-  sql_time::sql_time(const std::string &value) : value_(0), format_(TIMESTAMP) {
+  sql_time::sql_time(const std::string &value) : value_(), format_(TIMESTAMP) {
     if (!parse(value)) {
       throw value_conversion_error("unable to convert string to time");
     }
   }
+
+  sql_time sql_time::from_parts(int year, unsigned month, unsigned day, unsigned hour, unsigned minute,
+                                unsigned second, unsigned long microsecond, formats format) {
+    // time only values have no date
+    long long days = (month == 0 || day == 0) ? 0 : days_from_civil(year, month, day);
+
+    auto seconds = days * 86400LL + hour * 3600LL + minute * 60LL + second;
+
+    return sql_time(time_point(std::chrono::microseconds(seconds * MICROS_PER_SECOND +
+                                                         static_cast<long long>(microsecond))),
+                    format);
+  }
+
   sql_time::formats sql_time::format() const { return format_; }
 
-  time_t sql_time::value() const { return value_; }
+  time_t sql_time::value() const {
+    return static_cast<time_t>(floor_div(value_.time_since_epoch().count(), MICROS_PER_SECOND));
+  }
+
+  sql_time::time_point sql_time::to_time_point() const { return value_; }
+
+  long sql_time::microseconds() const {
+    return static_cast<long>(value_.time_since_epoch().count() - value() * MICROS_PER_SECOND);
+  }
 
   struct tm *sql_time::to_gmtime() const {
-    return gmtime(&value_);
+    thread_local struct tm result;
+    auto seconds = value();
+    return gmtime_r(&seconds, &result);
   }
 
   struct tm *sql_time::to_localtime() const {
-    return localtime(&value_);
+    thread_local struct tm result;
+    auto seconds = value();
+    return localtime_r(&seconds, &result);
   }
 
   sql_time::operator std::string() const { return to_string(); }
@@ -68,40 +398,26 @@ namespace coda::db {
   sql_time::operator std::wstring() const { return to_wstring(); }
 
   std::string sql_time::to_string() const {
-    char buf[500] = {0};
-
-    switch (format_) {
-      case sql_time::DATE:strftime(buf, sizeof(buf), "%Y-%m-%d", gmtime(&value_));
-        return buf;
-      case sql_time::TIME:strftime(buf, sizeof(buf), "%H:%M:%S", gmtime(&value_));
-        return buf;
-      default:
-      case sql_time::TIMESTAMP:
-      case sql_time::DATETIME:strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", gmtime(&value_));
-        return buf;
-    }
+    char buf[BUFFER_SIZE];
+
+    auto end = to_chars(buf, buf + sizeof(buf));
+
+    return std::string(buf, end == nullptr ? 0 : static_cast<size_t>(end - buf));
   }
 
   std::wstring sql_time::to_wstring() const {
-    wchar_t buf[500] = {0};
-
-    switch (format_) {
-      case sql_time::DATE:wcsftime(buf, sizeof(buf), L"%Y-%m-%d", gmtime(&value_));
-        return buf;
-      case sql_time::TIME:wcsftime(buf, sizeof(buf), L"%H:%M:%S", gmtime(&value_));
-        return buf;
-      default:
-      case sql_time::TIMESTAMP:
-      case sql_time::DATETIME:wcsftime(buf, sizeof(buf), L"%Y-%m-%d %H:%M:%S", gmtime(&value_));
-        return buf;
-    }
+    char buf[BUFFER_SIZE];
+
+    auto end = to_chars(buf, buf + sizeof(buf));
+
+    return std::wstring(buf, end == nullptr ? buf : end);
   }
 
   bool sql_time::operator==(const sql_time &other) const {
     return value_ == other.value_ && format_ == other.format_;
   }
 
-  sql_time::operator time_t() const { return value_; }
+  sql_time::operator time_t() const { return value(); }
 
   std::ostream &operator<<(std::ostream &out, const sql_time &value) {
     out << value.to_string();
@@ -1,8 +1,10 @@
 #ifndef CODA_DB_SQL_TIME_H
 #define CODA_DB_SQL_TIME_H
 
+#include <chrono>
 #include <ctime>
 #include <string>
+#include <string_view>
 
 namespace coda::db {
   /*!
@@ -15,12 +17,32 @@ namespace coda::db {
      */
     typedef enum { DATE, TIME, TIMESTAMP, DATETIME } formats;
 
+    /*!
+     * a point in time with microsecond precision
+     */
+    typedef std::chrono::time_point<std::chrono::system_clock, std::chrono::microseconds> time_point;
+
+    /*!
+     * a buffer size large enough to format any time
+     */
+    constexpr static const size_t BUFFER_SIZE = 48;
+
     /*!
      * @param value the unix timestamp
      * @param format the format to display
      */
     sql_time(time_t value = time(nullptr), formats format = TIMESTAMP);
 
+    /*!
+     * @param value the point in time
+     * @param format the format to display
+     */
+    sql_time(const time_point &value, formats format = TIMESTAMP);
+
+    /*!
+     * @param value the ISO-8601 text to parse
+     * @throws value_conversion_error if the text is not a time
+     */
     sql_time(const std::string &value);
 
     sql_time(const sql_time &other) = default;
@@ -38,8 +60,50 @@ namespace coda::db {
      */
     formats format() const;
 
+    /*!
+     * @return the unix timestamp, rounded down to the second
+     */
     time_t value() const;
 
+    /*!
+     * @return the point in time
+     */
+    time_point to_time_point() const;
+
+    /*!
+     * @return the microseconds past the second
+     */
+    long microseconds() const;
+
+    /*!
+     * builds a time from UTC calendar fields
+     * @return the time
+     */
+    static sql_time from_parts(int year, unsigned month, unsigned day, unsigned hour, unsigned minute,
+                               unsigned second, unsigned long microsecond, formats format);
+
+    /*!
+     * parses ISO-8601 text without allocating
+     * accepts "YYYY-MM-DD", "HH:MM:SS[.ffffff]" or both separated by a space or 'T', with an optional 'Z' or
+     * numeric zone offset, as well as a plain unix timestamp.
+     * a time alone may also be a signed elapsed time up to "838:59:59", such as "-01:00:00" or "100:00:00".
+     * in a date and time "24:00:00" and leap seconds are rejected rather than read as the start of the next day.
+     * @param value the text to parse
+     * @return true if the text was a time, otherwise this time is unchanged
+     */
+    bool parse(std::string_view value) noexcept;
+
+    /*!
+     * formats this time without allocating
+     * fractional seconds are only written when not zero.
+     * a TIME within 840 hours of the epoch is an elapsed time and is written with signed total hours,
+     * such as "-01:00:00" or "100:00:00", otherwise the time of day is written.
+     * @param first the start of the buffer
+     * @param last the end of the buffer
+     * @return the end of the formatted text, or nullptr if the buffer is too small
+     */
+    char *to_chars(char *first, char *last) const noexcept;
+
     operator time_t() const;
 
     operator std::string() const;
@@ -47,7 +111,7 @@ namespace coda::db {
     operator std::wstring() const;
 
     /*!
-     * @return a time structure based on the timestamp
+     * @return a time structure based on the timestamp, owned by the calling thread until its next call
      */
     struct tm *to_gmtime() const;
 
@@ -60,9 +124,7 @@ namespace coda::db {
     bool operator==(const sql_time &other) const;
 
    private:
-    bool parse(const std::string &value);
-
-    time_t value_;
+    time_point value_;
     formats format_;
   };
 
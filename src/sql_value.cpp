@@ -53,81 +53,281 @@ namespace coda::db {
       sql_number operator()(const sql_null_type &value) const { return sql_number(value); }
     };
   }  // namespace helper
+  namespace {
+    // the alternatives of a sql number, in the order of their type index
+    typedef std::variant<sql_null_type, bool, char, unsigned char, wchar_t, short, unsigned short, int, unsigned int,
+                         long, unsigned long, long long, unsigned long long, float, double, long double>
+        number_types;
+
+    template<typename T, size_t I = 0>
+    constexpr unsigned char number_index() {
+      if constexpr (std::is_same<T, std::variant_alternative_t<I, number_types>>::value) {
+        return I;
+      } else {
+        return number_index<T, I + 1>();
+      }
+    }
+
+    /**
+     * reads an inline number by its type index
+     */
+    template<size_t I = 0>
+    sql_number read_number(unsigned char index, const unsigned char *data) {
+      typedef std::variant_alternative_t<I, number_types> type;
+
+      if constexpr (I + 1 < std::variant_size<number_types>::value) {
+        if (index != I) {
+          return read_number<I + 1>(index, data);
+        }
+      }
+      if constexpr (sizeof(type) <= sizeof(long long)) {
+        type value;
+        memcpy(&value, data, sizeof(type));
+        return sql_number(value);
+      } else {
+        return sql_number();
+      }
+    }
+
+    /**
+     * writes a number inline, if it fits
+     */
+    class number_writer {
+     public:
+      number_writer(unsigned char *data, unsigned char &index) : data_(data), index_(index) {}
+
+      template<typename V>
+      bool operator()(const V &value) const {
+        if constexpr (sizeof(V) <= sizeof(long long)) {
+          memcpy(data_, &value, sizeof(V));
+          index_ = number_index<V>();
+          return true;
+        } else {
+          return false;
+        }
+      }
+
+     private:
+      unsigned char *data_;
+      unsigned char &index_;
+    };
+  }  // namespace
+
   const nullptr_t sql_null = nullptr;
 
-  sql_value::sql_value() : value_(sql_null) {}
+  static_assert(sizeof(sql_value) == 16, "sql values should be compact");
 
-  sql_value::sql_value(const sql_null_type &value) : value_(value) {}
+  sql_value::sql_value() : data_(), extra_(0), kind_(null_kind) {}
 
-  sql_value::sql_value(const sql_number &value) : value_(value) {}
+  sql_value::sql_value(const sql_value &other) noexcept : extra_(other.extra_), kind_(other.kind_) {
+    memcpy(data_, other.data_, sizeof(data_));
+    retain();
+  }
 
-  sql_value::sql_value(const sql_string &value) : value_(value) {}
+  sql_value::sql_value(sql_value &&other) noexcept : extra_(other.extra_), kind_(other.kind_) {
+    memcpy(data_, other.data_, sizeof(data_));
+    other.kind_ = null_kind;
+  }
 
-  sql_value::sql_value(const sql_wstring &value) : value_(value) {}
+  sql_value::~sql_value() { release(); }
 
-  sql_value::sql_value(const sql_time &value) : value_(value) {}
+  sql_value &sql_value::operator=(const sql_value &other) noexcept {
+    if (this != &other) {
+      other.retain();
+      release();
+      memcpy(data_, other.data_, sizeof(data_));
+      extra_ = other.extra_;
+      kind_ = other.kind_;
+    }
+    return *this;
+  }
 
-  sql_value::sql_value(const sql_blob &value) : value_(value) {}
+  sql_value &sql_value::operator=(sql_value &&other) noexcept {
+    if (this != &other) {
+      release();
+      memcpy(data_, other.data_, sizeof(data_));
+      extra_ = other.extra_;
+      kind_ = other.kind_;
+      other.kind_ = null_kind;
+    }
+    return *this;
+  }
 
-  sql_value::sql_value(const bool &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const sql_null_type &value) : sql_value() {}
 
-  sql_value::sql_value(const char &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const sql_number &value) : sql_value() {
+    if (value.apply_visitor<number_writer, bool>(number_writer(data_, extra_))) {
+      kind_ = number_kind;
+    } else {
+      share(extended_kind, value);
+    }
+  }
 
-  sql_value::sql_value(const unsigned char &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const sql_string &value) : sql_value() { set_text(value.data(), value.size()); }
 
-  sql_value::sql_value(const wchar_t &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const sql_wstring &value) : sql_value() { share(wstring_kind, value); }
 
-  sql_value::sql_value(const short &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const sql_time &value) : sql_value() {
+    auto micros = value.to_time_point().time_since_epoch().count();
+    memcpy(data_, &micros, sizeof(micros));
+    extra_ = static_cast<unsigned char>(value.format());
+    kind_ = time_kind;
+  }
 
-  sql_value::sql_value(const unsigned short &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const sql_blob &value) : sql_value() { share(blob_kind, value); }
 
-  sql_value::sql_value(const int &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const bool &value) : sql_value(sql_number(value)) {}
 
-  sql_value::sql_value(const unsigned int &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const char &value) : sql_value(sql_number(value)) {}
 
-  sql_value::sql_value(const long &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const unsigned char &value) : sql_value(sql_number(value)) {}
 
-  sql_value::sql_value(const unsigned long &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const wchar_t &value) : sql_value(sql_number(value)) {}
 
-  sql_value::sql_value(const long long &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const short &value) : sql_value(sql_number(value)) {}
 
-  sql_value::sql_value(const unsigned long long &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const unsigned short &value) : sql_value(sql_number(value)) {}
 
-  sql_value::sql_value(const float &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const int &value) : sql_value(sql_number(value)) {}
 
-  sql_value::sql_value(const double &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const unsigned int &value) : sql_value(sql_number(value)) {}
 
-  sql_value::sql_value(const long double &value) : value_(sql_number(value)) {}
+  sql_value::sql_value(const long &value) : sql_value(sql_number(value)) {}
 
-  sql_value::sql_value(const char *value, std::string::size_type len)
-      : value_(sql_string(value, std::min(len, strlen(value)))) {}
+  sql_value::sql_value(const unsigned long &value) : sql_value(sql_number(value)) {}
+
+  sql_value::sql_value(const long long &value) : sql_value(sql_number(value)) {}
+
+  sql_value::sql_value(const unsigned long long &value) : sql_value(sql_number(value)) {}
+
+  sql_value::sql_value(const float &value) : sql_value(sql_number(value)) {}
+
+  sql_value::sql_value(const double &value) : sql_value(sql_number(value)) {}
+
+  sql_value::sql_value(const long double &value) : sql_value(sql_number(value)) {}
+
+  sql_value::sql_value(const char *value, std::string::size_type len) : sql_value() {
+    set_text(value, std::min(len, strlen(value)));
+  }
 
   sql_value::sql_value(const wchar_t *value, std::string::size_type len)
-      : value_(sql_wstring(value, std::min(len, wcslen(value)))) {}
+      : sql_value(sql_wstring(value, std::min(len, wcslen(value)))) {}
+
+  template<typename T>
+  void sql_value::share(kinds kind, const T &value) {
+    counted *block = new shared<T>(value);
+    memcpy(data_, &block, sizeof(block));
+    kind_ = kind;
+  }
+
+  void sql_value::set_text(const char *value, size_t size) {
+    if (size <= INLINE_SIZE) {
+      memcpy(data_, value, size);
+      extra_ = static_cast<unsigned char>(size);
+      kind_ = text_kind;
+    } else {
+      share(string_kind, sql_string(value, size));
+    }
+  }
+
+  sql_value::counted *sql_value::shared_data() const noexcept {
+    counted *block = nullptr;
+    memcpy(&block, data_, sizeof(block));
+    return block;
+  }
+
+  bool sql_value::is_shared() const noexcept {
+    return kind_ == extended_kind || kind_ == string_kind || kind_ == wstring_kind || kind_ == blob_kind;
+  }
+
+  void sql_value::retain() const noexcept {
+    if (is_shared()) {
+      shared_data()->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  void sql_value::release() noexcept {
+    if (!is_shared() || shared_data()->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return;
+    }
+    switch (kind_) {
+      case extended_kind:
+        delete static_cast<shared<sql_number> *>(shared_data());
+        break;
+      case string_kind:
+        delete static_cast<shared<sql_string> *>(shared_data());
+        break;
+      case wstring_kind:
+        delete static_cast<shared<sql_wstring> *>(shared_data());
+        break;
+      case blob_kind:
+        delete static_cast<shared<sql_blob> *>(shared_data());
+        break;
+      default:
+        break;
+    }
+  }
+
+  sql_number sql_value::number() const {
+    if (kind_ == extended_kind) {
+      return shared_value<sql_number>();
+    }
+    return read_number(extra_, data_);
+  }
+
+  sql_time sql_value::time() const {
+    sql_time::time_point::rep micros = 0;
+    memcpy(&micros, data_, sizeof(micros));
+    return sql_time(sql_time::time_point(sql_time::time_point::duration(micros)),
+                    static_cast<sql_time::formats>(extra_));
+  }
+
+  std::string_view sql_value::as_view() const {
+    switch (kind_) {
+      case null_kind:
+        return std::string_view();
+      case text_kind:
+        return std::string_view(reinterpret_cast<const char *>(data_), extra_);
+      case string_kind:
+        return shared_value<sql_string>();
+      case blob_kind: {
+        const sql_blob &blob = shared_value<sql_blob>();
+        return std::string_view(static_cast<const char *>(blob.get()), blob.size());
+      }
+      default:
+        throw value_conversion_error("value can not be viewed");
+    }
+  }
 
   template<>
   sql_string sql_value::as() const {
-    return std::visit(helper::as_sql_string(), value_);
+    if (kind_ == text_kind || kind_ == string_kind) {
+      return sql_string(as_view());
+    }
+    return apply_visitor<helper::as_sql_string, sql_string>(helper::as_sql_string());
   }
 
   template<>
   sql_wstring sql_value::as() const {
-    return std::visit(helper::as_sql_wstring(), value_);
+    return apply_visitor<helper::as_sql_wstring, sql_wstring>(helper::as_sql_wstring());
   }
 
   template<>
   sql_time sql_value::as() const {
-    return std::visit(helper::as_sql_time(), value_);
+    return apply_visitor<helper::as_sql_time, sql_time>(helper::as_sql_time());
   }
 
   template<>
   sql_blob sql_value::as() const {
-    return std::visit(helper::as_sql_blob(), value_);
+    return apply_visitor<helper::as_sql_blob, sql_blob>(helper::as_sql_blob());
   }
 
   template<>
   sql_number sql_value::as() const {
-    return std::visit(helper::as_sql_number(), value_);
+    if (kind_ == number_kind || kind_ == extended_kind) {
+      return number();
+    }
+    return apply_visitor<helper::as_sql_number, sql_number>(helper::as_sql_number());
   }
 
   sql_value::operator sql_number() const {
@@ -259,7 +459,7 @@ namespace coda::db {
   }
 
   bool sql_value::operator==(const sql_value &value) const {
-    return std::visit(helper::value_equality(value), value_);
+    return apply_visitor<helper::value_equality, bool>(helper::value_equality(value));
   }
 
   bool sql_value::operator==(const sql_null_type &value) const { return is<sql_null_type>(); }
@@ -5,6 +5,8 @@
 #ifndef CODA_DB_SQL_VALUE_H
 #define CODA_DB_SQL_VALUE_H
 
+#include <atomic>
+#include <string_view>
 #include <type_traits>
 #include "sql_number.h"
 #include "sql_time.h"
@@ -12,18 +14,20 @@
 namespace coda::db {
   /*!
    * A sql value
+   * Values are a 16 byte tagged union.  Numbers, times and short strings are stored inline, while long strings,
+   * wide strings and blobs are held in reference counted storage shared between copies.
    */
-  class sql_value : public sql_value_convertible {
+  class sql_value {
    public:
     sql_value();
 
-    sql_value(const sql_value &other) = default;
-    sql_value(sql_value &&other) noexcept = default;
+    sql_value(const sql_value &other) noexcept;
+    sql_value(sql_value &&other) noexcept;
 
-    ~sql_value() = default;
+    ~sql_value();
 
-    sql_value &operator=(const sql_value &other) = default;
-    sql_value &operator=(sql_value &&other) noexcept = default;
+    sql_value &operator=(const sql_value &other) noexcept;
+    sql_value &operator=(sql_value &&other) noexcept;
 
     sql_value(const sql_null_type &value);
 
@@ -75,112 +79,224 @@ namespace coda::db {
     sql_value(const wchar_t *value, std::wstring::size_type len = std::wstring::npos);
 
     template<typename T, typename = std::enable_if<is_sql_value<T>::value || is_sql_number<T>::value>>
-    constexpr bool is() const noexcept {
-      return std::visit(helper::is_type<T>(), value_);
+    bool is() const noexcept {
+      switch (kind_) {
+        case number_kind:
+        case extended_kind:
+          return is_kind<T, sql_number>();
+        case text_kind:
+        case string_kind:
+          return is_kind<T, sql_string>();
+        case wstring_kind:
+          return is_kind<T, sql_wstring>();
+        case time_kind:
+          return is_kind<T, sql_time>();
+        case blob_kind:
+          return is_kind<T, sql_blob>();
+        default:
+          return is_kind<T, sql_null_type>();
+      }
     }
 
     template<typename T, typename = std::enable_if<is_sql_number<T>::value>>
-    constexpr T as() const {
-      return std::visit(helper::as_number<T>(), value_);
+    T as() const {
+      if (kind_ == number_kind || kind_ == extended_kind) {
+        return number();
+      }
+      return apply_visitor<helper::as_number<T>, T>(helper::as_number<T>());
     }
 
-    operator sql_number() const override;
+    /*!
+     * views the characters of a string or the bytes of a blob without copying
+     * the view is valid as long as this value (or a copy of it) is unchanged
+     * @return the view of the data, empty for a null value
+     * @throws value_conversion_error if the value is not a string or blob
+     */
+    std::string_view as_view() const;
+
+    operator sql_number() const;
 
-    operator sql_string() const override;
+    operator sql_string() const;
 
-    operator sql_wstring() const override;
+    operator sql_wstring() const;
 
-    operator sql_time() const override;
+    operator sql_time() const;
 
-    operator sql_blob() const override;
+    operator sql_blob() const;
 
     /* numeric implicits */
 
-    operator short() const override;
+    operator short() const;
 
-    operator unsigned short() const override;
+    operator unsigned short() const;
 
-    operator int() const override;
+    operator int() const;
 
-    operator unsigned int() const override;
+    operator unsigned int() const;
 
-    operator long() const override;
+    operator long() const;
 
-    operator unsigned long() const override;
+    operator unsigned long() const;
 
-    operator long long() const override;
+    operator long long() const;
 
-    operator unsigned long long() const override;
+    operator unsigned long long() const;
 
-    operator float() const override;
+    operator float() const;
 
-    operator double() const override;
+    operator double() const;
 
-    operator long double() const override;
+    operator long double() const;
 
     bool operator==(const sql_value &other) const;
 
-    bool operator==(const sql_null_type &other) const override;
+    bool operator==(const sql_null_type &other) const;
 
-    bool operator==(const sql_number &value) const override;
+    bool operator==(const sql_number &value) const;
 
-    bool operator==(const sql_string &value) const override;
+    bool operator==(const sql_string &value) const;
 
-    bool operator==(const sql_wstring &value) const override;
+    bool operator==(const sql_wstring &value) const;
 
-    bool operator==(const sql_time &value) const override;
+    bool operator==(const sql_time &value) const;
 
-    bool operator==(const sql_blob &value) const override;
+    bool operator==(const sql_blob &value) const;
 
-    bool operator==(const char * value) const override;
+    bool operator==(const char * value) const;
 
     /* numeric equality */
-    bool operator==(const bool &value) const override;
+    bool operator==(const bool &value) const;
 
-    bool operator==(const char &value) const override;
+    bool operator==(const char &value) const;
 
-    bool operator==(const unsigned char &value) const override;
+    bool operator==(const unsigned char &value) const;
 
-    bool operator==(const wchar_t &value) const override;
+    bool operator==(const wchar_t &value) const;
 
-    bool operator==(const short &value) const override;
+    bool operator==(const short &value) const;
 
-    bool operator==(const unsigned short &value) const override;
+    bool operator==(const unsigned short &value) const;
 
-    bool operator==(const int &value) const override;
+    bool operator==(const int &value) const;
 
-    bool operator==(const unsigned int &value) const override;
+    bool operator==(const unsigned int &value) const;
 
-    bool operator==(const long &value) const override;
+    bool operator==(const long &value) const;
 
-    bool operator==(const unsigned long &value) const override;
+    bool operator==(const unsigned long &value) const;
 
-    bool operator==(const long long &value) const override;
+    bool operator==(const long long &value) const;
 
-    bool operator==(const unsigned long long &value) const override;
+    bool operator==(const unsigned long long &value) const;
 
-    bool operator==(const float &value) const override;
+    bool operator==(const float &value) const;
 
-    bool operator==(const double &value) const override;
+    bool operator==(const double &value) const;
 
-    bool operator==(const long double &value) const override;
+    bool operator==(const long double &value) const;
 
     std::string to_string() const;
 
     std::wstring to_wstring() const;
 
+    /*!
+     * calls the visitor with the value as one of sql_null_type, sql_number, sql_string, sql_wstring, sql_time or
+     * sql_blob. Inline values are passed as temporaries, so the visitor should not keep references to them.
+     */
     template<typename V, typename T>
     T apply_visitor(const V &visitor) const {
-      return std::visit(visitor, value_);
+      switch (kind_) {
+        case number_kind:
+        case extended_kind:
+          return static_cast<T>(visitor(number()));
+        case text_kind:
+          return static_cast<T>(visitor(sql_string(reinterpret_cast<const char *>(data_), extra_)));
+        case string_kind:
+          return static_cast<T>(visitor(shared_value<sql_string>()));
+        case wstring_kind:
+          return static_cast<T>(visitor(shared_value<sql_wstring>()));
+        case time_kind:
+          return static_cast<T>(visitor(time()));
+        case blob_kind:
+          return static_cast<T>(visitor(shared_value<sql_blob>()));
+        default:
+          return static_cast<T>(visitor(sql_null));
+      }
     }
 
     template<typename V>
     void apply_visitor(const V &visitor) const {
-      std::visit(visitor, value_);
+      apply_visitor<V, void>(visitor);
     }
 
    private:
-    std::variant<sql_null_type, sql_number, sql_string, sql_wstring, sql_time, sql_blob> value_;
+    /*!
+     * the type of value stored
+     */
+    typedef enum : unsigned char {
+      null_kind,
+      number_kind,
+      extended_kind,
+      text_kind,
+      string_kind,
+      wstring_kind,
+      time_kind,
+      blob_kind
+    } kinds;
+
+    /*!
+     * the reference count of values too large to be inline
+     */
+    struct counted {
+      std::atomic<long> refs{1};
+    };
+
+    /*!
+     * reference counted storage for values too large to be inline
+     */
+    template<typename T>
+    struct shared : public counted {
+      shared(const T &value) : value(value) {}
+      T value;
+    };
+
+    /*!
+     * the largest string that will be stored inline
+     */
+    constexpr static const size_t INLINE_SIZE = 14;
+
+    template<typename T, typename V>
+    constexpr static bool is_kind() noexcept {
+      return std::is_same<T, V>::value || std::is_convertible<V, T>::value;
+    }
+
+    template<typename T>
+    const T &shared_value() const noexcept {
+      return static_cast<const shared<T> *>(shared_data())->value;
+    }
+
+    template<typename T>
+    void share(kinds kind, const T &value);
+
+    void set_text(const char *value, size_t size);
+
+    counted *shared_data() const noexcept;
+
+    bool is_shared() const noexcept;
+
+    void retain() const noexcept;
+
+    void release() noexcept;
+
+    sql_number number() const;
+
+    sql_time time() const;
+
+    // the storage for the inline value or the pointer to the shared value
+    alignas(8) unsigned char data_[INLINE_SIZE];
+    // the number type, the time format or the inline string length
+    unsigned char extra_;
+    kinds kind_;
   };
 
   template<>
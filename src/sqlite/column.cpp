@@ -27,6 +27,28 @@ namespace coda::db::sqlite {
         }
       }
     }
+
+    string_view to_view(const shared_ptr<sqlite3_stmt> &stmt, int column) {
+      if (stmt == nullptr || column < 0 || column >= sqlite3_column_count(stmt.get())) {
+        throw no_such_column_exception();
+      }
+
+      // the pointer is requested before the size, as the size may change on conversion
+      switch (sqlite3_column_type(stmt.get(), column)) {
+        case SQLITE_NULL:
+          return string_view();
+        case SQLITE_BLOB: {
+          auto data = static_cast<const char *>(sqlite3_column_blob(stmt.get(), column));
+          return string_view(data, static_cast<size_t>(sqlite3_column_bytes(stmt.get(), column)));
+        }
+        default: {
+          auto data = reinterpret_cast<const char *>(sqlite3_column_text(stmt.get(), column));
+          return string_view(data, static_cast<size_t>(sqlite3_column_bytes(stmt.get(), column)));
+        }
+      }
+    }
+
+    string_view to_view(const sql_value &value) { return value.as_view(); }
   }  // namespace data_mapper
 
   column::column(const shared_ptr<sqlite3_stmt> &stmt, int column) : stmt_(stmt), column_(column) {}
@@ -54,4 +76,39 @@ namespace coda::db::sqlite {
     }
     return sqlite3_column_name(stmt_.get(), column_);
   }
+
+  string_view column::to_view() const {
+    if (!is_valid()) {
+      throw no_such_column_exception();
+    }
+    return data_mapper::to_view(stmt_, column_);
+  }
+
+  buffered_column::buffered_column(const shared_ptr<const vector<sql_value>> &values,
+                                   const shared_ptr<column_index> &columns, size_t column)
+      : values_(values), columns_(columns), column_(column) {}
+
+  bool buffered_column::is_valid() const { return values_ != nullptr && column_ < values_->size(); }
+
+  sql_value buffered_column::to_value() const {
+    if (!is_valid()) {
+      throw no_such_column_exception();
+    }
+
+    return (*values_)[column_];
+  }
+
+  string buffered_column::name() const {
+    if (!is_valid() || columns_ == nullptr) {
+      return string();
+    }
+    return columns_->name(column_);
+  }
+
+  string_view buffered_column::to_view() const {
+    if (!is_valid()) {
+      throw no_such_column_exception();
+    }
+    return data_mapper::to_view((*values_)[column_]);
+  }
 }  // namespace coda::db::sqlite
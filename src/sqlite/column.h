@@ -5,9 +5,17 @@
 #define CODA_DB_SQLITE_COLUMN_H
 
 #include <sqlite3.h>
+#include <vector>
 #include "../column.h"
+#include "../column_index.h"
 
 namespace coda::db::sqlite {
+  namespace data_mapper {
+    sql_value to_value(const std::shared_ptr<sqlite3_stmt> &stmt, int column);
+    std::string_view to_view(const std::shared_ptr<sqlite3_stmt> &stmt, int column);
+    std::string_view to_view(const sql_value &value);
+  }  // namespace data_mapper
+
   /*!
    * a sqlite specific implementation of a column
    */
@@ -35,6 +43,39 @@ namespace coda::db::sqlite {
     sql_value to_value() const override;
     int sql_type() const;
     std::string name() const override;
+    std::string_view to_view() const override;
+  };
+
+  /*!
+   * a sqlite column from results that have been read into memory
+   */
+  class buffered_column : public column_impl {
+   private:
+    std::shared_ptr<const std::vector<sql_value>> values_;
+    std::shared_ptr<column_index> columns_;
+    size_t column_;
+
+   public:
+    /*!
+     * @param values  the values of the row
+     * @param columns the column names of the results
+     * @param column  the column index
+     */
+    buffered_column(const std::shared_ptr<const std::vector<sql_value>> &values,
+                    const std::shared_ptr<column_index> &columns, size_t column);
+
+    /* non-copyable boilerplate */
+    buffered_column(const buffered_column &other) = delete;
+    buffered_column(buffered_column &&other) noexcept = default;
+    ~buffered_column() = default;
+    buffered_column &operator=(const buffered_column &other) = delete;
+    buffered_column &operator=(buffered_column &&other) noexcept = default;
+
+    /* column_impl overrides */
+    bool is_valid() const override;
+    sql_value to_value() const override;
+    std::string name() const override;
+    std::string_view to_view() const override;
   };
 }  // namespace coda::db::sqlite
 
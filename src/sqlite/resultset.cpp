@@ -1,12 +1,20 @@
 #include "resultset.h"
+#include "column.h"
 #include "row.h"
 #include "session.h"
 
 using namespace std;
 
+namespace coda::db {
+  namespace helper {
+    extern string fold_case(const string &value);
+  }
+}  // namespace coda::db
+
 namespace coda::db::sqlite {
-  resultset::resultset(const std::shared_ptr<sqlite::session> &sess, const shared_ptr<sqlite3_stmt> &stmt)
-      : stmt_(stmt), sess_(sess), status_(-1) {
+  resultset::resultset(const std::shared_ptr<sqlite::session> &sess, const shared_ptr<sqlite3_stmt> &stmt,
+                       bool buffered)
+      : stmt_(stmt), sess_(sess), status_(-1), buffered_(buffered), position_(npos) {
     if (sess_ == nullptr) {
       throw database_exception("No database provided to sqlite3 resultset");
     }
@@ -14,6 +22,33 @@ namespace coda::db::sqlite {
     if (stmt_ == nullptr) {
       throw database_exception("no statement provided to sqlite3 resultset");
     }
+
+    if (buffered_) {
+      buffer();
+    }
+  }
+
+  void resultset::buffer() {
+    auto count = sqlite3_column_count(stmt_.get());
+
+    while ((status_ = sqlite3_step(stmt_.get())) == SQLITE_ROW) {
+      auto values = make_shared<vector<sql_value>>();
+
+      values->reserve(static_cast<size_t>(count));
+
+      for (int i = 0; i < count; i++) {
+        values->push_back(data_mapper::to_value(stmt_, i));
+      }
+
+      rows_.push_back(values);
+    }
+
+    if (status_ != SQLITE_DONE) {
+      throw database_exception(sess_->last_error());
+    }
+
+    // the statement is no longer needed for the rows, so release it for reuse
+    sqlite3_reset(stmt_.get());
   }
 
   bool resultset::is_valid() const noexcept { return stmt_ != nullptr && stmt_; }
@@ -23,6 +58,15 @@ namespace coda::db::sqlite {
       return false;
     }
 
+    if (buffered_) {
+      if (position_ == npos) {
+        position_ = 0;
+      } else if (position_ < rows_.size()) {
+        position_++;
+      }
+      return position_ < rows_.size();
+    }
+
     if (status_ == SQLITE_DONE) {
       return false;
     }
@@ -38,11 +82,203 @@ namespace coda::db::sqlite {
       return;
     }
 
+    if (buffered_) {
+      position_ = npos;
+      return;
+    }
+
     if (sqlite3_reset(stmt_.get()) != SQLITE_OK) {
       throw database_exception(sess_->last_error());
     }
     status_ = -1;
   }
 
-  resultset::row_type resultset::current_row() { return row_type(make_shared<row>(sess_, stmt_)); }
+  resultset::row_type resultset::current_row() {
+    if (!buffered_) {
+      return row_type(make_shared<row>(sess_, stmt_, columns()));
+    }
+
+    if (position_ >= rows_.size()) {
+      return row_type();
+    }
+
+    return row_type(make_shared<buffered_row>(rows_[position_], columns()));
+  }
+
+  size_t resultset::column_count() { return is_valid() ? sqlite3_column_count(stmt_.get()) : 0; }
+
+  sql_value resultset::column_value(size_t index) {
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+
+    if (buffered_) {
+      if (position_ >= rows_.size()) {
+        throw no_such_column_exception();
+      }
+      return (*rows_[position_])[index];
+    }
+
+    return data_mapper::to_value(stmt_, static_cast<int>(index));
+  }
+
+  string resultset::column_name(size_t index) {
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+    return sqlite3_column_name(stmt_.get(), static_cast<int>(index));
+  }
+
+  bool resultset::column_is_null(size_t index) {
+    if (buffered_) {
+      return resultset_impl::column_is_null(index);
+    }
+
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+    return sqlite3_column_type(stmt_.get(), static_cast<int>(index)) == SQLITE_NULL;
+  }
+
+  long long resultset::column_int64(size_t index) {
+    if (buffered_) {
+      return resultset_impl::column_int64(index);
+    }
+
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+    return sqlite3_column_int64(stmt_.get(), static_cast<int>(index));
+  }
+
+  double resultset::column_double(size_t index) {
+    if (buffered_) {
+      return resultset_impl::column_double(index);
+    }
+
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+    return sqlite3_column_double(stmt_.get(), static_cast<int>(index));
+  }
+
+  string resultset::column_text(size_t index) {
+    if (buffered_) {
+      return resultset_impl::column_text(index);
+    }
+
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+
+    auto column = static_cast<int>(index);
+
+    auto text = sqlite3_column_text(stmt_.get(), column);
+
+    if (text == nullptr) {
+      return string();
+    }
+
+    return string(reinterpret_cast<const char *>(text), static_cast<size_t>(sqlite3_column_bytes(stmt_.get(), column)));
+  }
+
+  string_view resultset::column_data(size_t index) {
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+
+    if (buffered_) {
+      if (position_ >= rows_.size()) {
+        throw no_such_column_exception();
+      }
+      return data_mapper::to_view((*rows_[position_])[index]);
+    }
+
+    return data_mapper::to_view(stmt_, static_cast<int>(index));
+  }
+
+  batch_column::type resultset::batch_type(size_t index) {
+    if (index >= column_count()) {
+      throw no_such_column_exception();
+    }
+
+    auto column = static_cast<int>(index);
+
+    auto decl = sqlite3_column_decltype(stmt_.get(), column);
+
+    // the type affinity rules, falling back to the type of the current value
+    if (decl != nullptr) {
+      string type = helper::fold_case(decl);
+
+      if (type.find("int") != string::npos) {
+        return batch_column::integer;
+      }
+      if (type.find("char") != string::npos || type.find("clob") != string::npos ||
+          type.find("text") != string::npos) {
+        return batch_column::text;
+      }
+      if (type.find("blob") != string::npos) {
+        return batch_column::blob;
+      }
+      if (type.find("real") != string::npos || type.find("floa") != string::npos ||
+          type.find("doub") != string::npos) {
+        return batch_column::real;
+      }
+    }
+
+    if (buffered_) {
+      return resultset_impl::batch_type(index);
+    }
+
+    switch (sqlite3_column_type(stmt_.get(), column)) {
+      case SQLITE_INTEGER:
+        return batch_column::integer;
+      case SQLITE_FLOAT:
+        return batch_column::real;
+      case SQLITE_BLOB:
+        return batch_column::blob;
+      default:
+        return batch_column::text;
+    }
+  }
+
+  void resultset::append_batch(column_batch &batch) {
+    if (buffered_) {
+      resultset_impl::append_batch(batch);
+      return;
+    }
+
+    auto stmt = stmt_.get();
+
+    for (size_t i = 0; i < batch.column_count(); i++) {
+      auto &column = batch.column(i);
+      auto index = static_cast<int>(i);
+
+      if (sqlite3_column_type(stmt, index) == SQLITE_NULL) {
+        column.append_null();
+        continue;
+      }
+
+      switch (column.kind()) {
+        case batch_column::integer:
+          column.append(static_cast<long long>(sqlite3_column_int64(stmt, index)));
+          break;
+        case batch_column::real:
+          column.append(sqlite3_column_double(stmt, index));
+          break;
+        case batch_column::text: {
+          auto text = reinterpret_cast<const char *>(sqlite3_column_text(stmt, index));
+          column.append(text, static_cast<size_t>(sqlite3_column_bytes(stmt, index)));
+          break;
+        }
+        case batch_column::blob: {
+          auto blob = static_cast<const char *>(sqlite3_column_blob(stmt, index));
+          column.append(blob, static_cast<size_t>(sqlite3_column_bytes(stmt, index)));
+          break;
+        }
+      }
+    }
+  }
+
+  size_t resultset::row_count() { return buffered_ ? rows_.size() : npos; }
 }  // namespace coda::db::sqlite
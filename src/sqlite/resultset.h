@@ -20,13 +20,20 @@ namespace coda::db::sqlite {
     std::shared_ptr<sqlite3_stmt> stmt_;
     std::shared_ptr<sqlite::session> sess_;
     int status_;
+    bool buffered_;
+    std::vector<std::shared_ptr<const std::vector<sql_value>>> rows_;
+    size_t position_;
+    void buffer();
 
    public:
     /*!
      * @param  db   the database in use
      * @param  stmt the query statement in use
+     * @param  buffered true to read all the rows into memory up front, so that
+     *                  the rows can be counted and reset without running the query again
      */
-    resultset(const std::shared_ptr<sqlite::session> &sess, const std::shared_ptr<sqlite3_stmt> &stmt);
+    resultset(const std::shared_ptr<sqlite::session> &sess, const std::shared_ptr<sqlite3_stmt> &stmt,
+              bool buffered = false);
 
     /* non-copyable boilerplate */
     resultset(const resultset &other) = delete;
@@ -43,6 +50,21 @@ namespace coda::db::sqlite {
      */
     void reset() override;
     bool next() override;
+    size_t column_count() override;
+    sql_value column_value(size_t index) override;
+    std::string column_name(size_t index) override;
+    bool column_is_null(size_t index) override;
+    long long column_int64(size_t index) override;
+    double column_double(size_t index) override;
+    std::string column_text(size_t index) override;
+    std::string_view column_data(size_t index) override;
+    batch_column::type batch_type(size_t index) override;
+    void append_batch(column_batch &batch) override;
+
+    /*!
+     * @return the number of rows if buffered, otherwise npos
+     */
+    size_t row_count() override;
   };
 }  // namespace coda::db::sqlite
 
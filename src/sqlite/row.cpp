@@ -5,8 +5,9 @@
 using namespace std;
 
 namespace coda::db::sqlite {
-  row::row(const std::shared_ptr<sqlite::session> &sess, const shared_ptr<sqlite3_stmt> &stmt)
-      : row_impl(), stmt_(stmt), sess_(sess) {
+  row::row(const std::shared_ptr<sqlite::session> &sess, const shared_ptr<sqlite3_stmt> &stmt,
+           const shared_ptr<column_index> &columns)
+      : row_impl(), stmt_(stmt), sess_(sess), columns_(columns) {
     if (sess_ == nullptr) {
       throw database_exception("no database provided to sqlite3 row");
     }
@@ -31,6 +32,16 @@ namespace coda::db::sqlite {
       throw no_such_column_exception();
     }
 
+    if (columns_ != nullptr) {
+      auto index = columns_->find(name);
+
+      if (index == column_index::npos) {
+        throw no_such_column_exception(name);
+      }
+
+      return column(index);
+    }
+
     for (size_t i = 0; i < size_; i++) {
       const char *col_name = sqlite3_column_name(stmt_.get(), i);
 
@@ -52,4 +63,49 @@ namespace coda::db::sqlite {
   size_t row::size() const noexcept { return size_; }
 
   bool row::is_valid() const noexcept { return stmt_ != nullptr; }
+
+  buffered_row::buffered_row(const shared_ptr<const vector<sql_value>> &values, const shared_ptr<column_index> &columns)
+      : row_impl(), values_(values), columns_(columns) {
+    if (values_ == nullptr) {
+      throw database_exception("no values provided to sqlite3 row");
+    }
+
+    if (columns_ == nullptr) {
+      throw database_exception("no columns provided to sqlite3 row");
+    }
+  }
+
+  buffered_row::column_type buffered_row::column(size_t nPosition) const {
+    if (nPosition >= size()) {
+      throw no_such_column_exception();
+    }
+
+    return column_type(make_shared<sqlite::buffered_column>(values_, columns_, nPosition));
+  }
+
+  buffered_row::column_type buffered_row::column(const string &name) const {
+    if (name.empty()) {
+      throw no_such_column_exception();
+    }
+
+    auto index = columns_->find(name);
+
+    if (index == column_index::npos) {
+      throw no_such_column_exception(name);
+    }
+
+    return column(index);
+  }
+
+  string buffered_row::column_name(size_t nPosition) const {
+    if (nPosition >= size()) {
+      throw no_such_column_exception();
+    }
+
+    return columns_->name(nPosition);
+  }
+
+  size_t buffered_row::size() const noexcept { return values_->size(); }
+
+  bool buffered_row::is_valid() const noexcept { return values_ != nullptr; }
 }  // namespace coda::db::sqlite
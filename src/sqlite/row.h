@@ -6,6 +6,7 @@
 
 #include <sqlite3.h>
 #include <vector>
+#include "../column_index.h"
 #include "../row.h"
 
 namespace coda::db::sqlite {
@@ -18,14 +19,17 @@ namespace coda::db::sqlite {
    private:
     std::shared_ptr<sqlite3_stmt> stmt_;
     std::shared_ptr<sqlite::session> sess_;
+    std::shared_ptr<column_index> columns_;
     size_t size_;
 
    public:
     /*!
      * @param db    the database in use
      * @param stmt  the query statement in use
+     * @param columns the shared column name index, if any
      */
-    row(const std::shared_ptr<sqlite::session> &sess, const std::shared_ptr<sqlite3_stmt> &stmt);
+    row(const std::shared_ptr<sqlite::session> &sess, const std::shared_ptr<sqlite3_stmt> &stmt,
+        const std::shared_ptr<column_index> &columns = nullptr);
 
     /* non-copyable boilerplate */
     ~row() override = default;
@@ -41,6 +45,37 @@ namespace coda::db::sqlite {
     size_t size() const noexcept override;
     bool is_valid() const noexcept override;
   };
+
+  /*!
+   * a sqlite row from results that have been read into memory
+   */
+  class buffered_row : public row_impl {
+   private:
+    std::shared_ptr<const std::vector<sql_value>> values_;
+    std::shared_ptr<column_index> columns_;
+
+   public:
+    /*!
+     * @param values  the values of the row
+     * @param columns the column names of the results
+     */
+    buffered_row(const std::shared_ptr<const std::vector<sql_value>> &values,
+                 const std::shared_ptr<column_index> &columns);
+
+    /* non-copyable boilerplate */
+    ~buffered_row() override = default;
+    buffered_row(const buffered_row &other) = delete;
+    buffered_row(buffered_row &&other) noexcept = default;
+    buffered_row &operator=(const buffered_row &other) = delete;
+    buffered_row &operator=(buffered_row &&other) noexcept = default;
+
+    /* row_impl overrides */
+    std::string column_name(size_t nPosition) const override;
+    column_type column(size_t nPosition) const override;
+    column_type column(const std::string &name) const override;
+    size_t size() const noexcept override;
+    bool is_valid() const noexcept override;
+  };
 }  // namespace coda::db::sqlite
 
 #endif
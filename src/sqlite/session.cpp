@@ -1,5 +1,6 @@
 
 #include "session.h"
+#include <algorithm>
 #include <sstream>
 #include "../exception.h"
 #include "../schema.h"
@@ -29,7 +30,7 @@ namespace coda::db::sqlite {
 
   std::shared_ptr<coda::db::session_impl> factory::create(const uri &uri) { return std::make_shared<session>(uri); }
 
-  session::session(const uri &info) : session_impl(info), db_(nullptr) {}
+  session::session(const uri &info) : session_impl(info), bufferedResults_(false), db_(nullptr) {}
 
   session::~session() {
     if (is_open()) {
@@ -121,7 +122,9 @@ namespace coda::db::sqlite {
     return static_cast<unsigned long long int>(sqlite3_changes(db_.get()));
   }
 
-  std::shared_ptr<resultset_impl> session::query(const string &sql) {
+  std::shared_ptr<resultset_impl> session::query(const string &sql) { return query(sql, bufferedResults_); }
+
+  std::shared_ptr<resultset_impl> session::query(const string &sql, bool buffered) {
     sqlite3_stmt *stmt;
 
     if (db_ == nullptr) {
@@ -132,7 +135,7 @@ namespace coda::db::sqlite {
       throw database_exception(last_error());
     }
 
-    return make_shared<resultset>(shared_from_this(), shared_ptr<sqlite3_stmt>(stmt, helper::stmt_delete()));
+    return make_shared<resultset>(shared_from_this(), shared_ptr<sqlite3_stmt>(stmt, helper::stmt_delete()), buffered);
   }
 
   bool session::execute(const string &sql) {
@@ -167,5 +170,30 @@ namespace coda::db::sqlite {
 
   std::string session::bind_param(size_t index) const { return "?" + std::to_string(index); }
 
-  constexpr int session::features() const { return db::session::FEATURE_NAMED_PARAMS; }
+  constexpr int session::features() const {
+#if SQLITE_VERSION_NUMBER >= 3024000
+    return db::session::FEATURE_NAMED_PARAMS | db::session::FEATURE_ON_CONFLICT;
+#else
+    return db::session::FEATURE_NAMED_PARAMS;
+#endif
+  }
+
+  size_t session::max_bind_params() const {
+    if (db_ == nullptr) {
+      return session_impl::max_bind_params();
+    }
+
+    // 999 before 3.32.0, 32766 after, or whatever the library was compiled with
+    auto limit = static_cast<size_t>(sqlite3_limit(db_.get(), SQLITE_LIMIT_VARIABLE_NUMBER, -1));
+
+    // preparing numbered parameters (?NNN) is quadratic, so past the old default
+    // the prepare time outweighs the saved round trips
+    return std::min<size_t>(limit, session_impl::max_bind_params());
+  }
+
+  bool session::in_transaction() const noexcept { return db_ != nullptr && !sqlite3_get_autocommit(db_.get()); }
+
+  bool session::buffered_results() const noexcept { return bufferedResults_; }
+
+  void session::set_buffered_results(bool value) noexcept { bufferedResults_ = value; }
 }  // namespace coda::db::sqlite
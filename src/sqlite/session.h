@@ -24,6 +24,9 @@ namespace coda::db::sqlite {
     friend class factory;
     friend class statement;
 
+   private:
+    bool bufferedResults_;
+
    protected:
     std::shared_ptr<sqlite3> db_;
 
@@ -62,6 +65,28 @@ namespace coda::db::sqlite {
     std::string bind_param(size_t index) const override;
 
     [[nodiscard]] constexpr int features() const override;
+    size_t max_bind_params() const override;
+    bool in_transaction() const noexcept override;
+
+    /*!
+     * queries the database
+     * @param sql      the sql to execute
+     * @param buffered true to read all the rows into memory before returning
+     * @return the results of the query
+     */
+    std::shared_ptr<resultset_impl> query(const std::string &sql, bool buffered);
+
+    /*!
+     * @return true if query results are read into memory by default
+     */
+    bool buffered_results() const noexcept;
+
+    /*!
+     * sets the default result mode for queries and statements.  buffered results
+     * know their size and can be reset without running the query again.
+     * @param value true to buffer results
+     */
+    void set_buffered_results(bool value) noexcept;
   };
 }  // namespace coda::db::sqlite
 
@@ -1,4 +1,5 @@
 #include "statement.h"
+#include "../unicode.h"
 #include "resultset.h"
 #include "session.h"
 
@@ -61,7 +62,10 @@ namespace coda::db::sqlite {
       }
 
       bool operator()(const std::wstring &value) const {
-        return sqlite3_bind_text16(stmt_.get(), index_, value.c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK;
+        // wchar_t is not UTF-16 on every platform, so bind as UTF-8
+        auto text = db::helper::to_utf8(value);
+
+        return sqlite3_bind_text(stmt_.get(), index_, text.c_str(), text.size(), SQLITE_TRANSIENT) == SQLITE_OK;
       }
 
       bool operator()(const std::string &value) const {
@@ -105,6 +109,8 @@ namespace coda::db::sqlite {
 
   bool statement::is_valid() const noexcept { return stmt_ != nullptr && stmt_; }
 
+  bool statement::is_busy() const noexcept { return stmt_ != nullptr && stmt_.use_count() > 1; }
+
   unsigned long long statement::last_number_of_changes() { return sess_->last_number_of_changes(); }
 
   string statement::last_error() { return sess_->last_error(); }
@@ -144,7 +150,12 @@ namespace coda::db::sqlite {
       throw database_exception("sqlite statement results invalid database");
     }
 
-    return resultset_type(make_shared<resultset>(sess_, stmt_));
+    // new results start from the first row, even if earlier results were partially read
+    if (is_valid() && sqlite3_stmt_busy(stmt_.get())) {
+      reset();
+    }
+
+    return resultset_type(make_shared<resultset>(sess_, stmt_, sess_->buffered_results()));
   }
 
   bool statement::execute() {
@@ -36,6 +36,7 @@ namespace coda::db::sqlite {
     /* statement overrides */
     void prepare(const std::string &sql) override;
     bool is_valid() const noexcept override;
+    bool is_busy() const noexcept override;
     resultset_type query() override;
     bool execute() override;
     void finish() override;
@@ -55,6 +55,12 @@ namespace coda::db {
      */
     virtual bool is_valid() const noexcept = 0;
 
+    /*!
+     * tests if results from this statement are still being read
+     * @return true if a resultset still refers to this statement
+     */
+    virtual bool is_busy() const noexcept = 0;
+
     /*!
      * executes this statement
      * @return a set of the results
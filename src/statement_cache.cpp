@@ -0,0 +1,214 @@
+/*!
+ * @copyright ryan jennings (coda.life), 2013
+ */
+#include "statement_cache.h"
+#include <vector>
+#include "statement.h"
+
+using namespace std;
+
+namespace coda::db {
+
+  struct statement_cache::storage {
+    struct entry {
+      std::string sql;
+      std::shared_ptr<statement_type> value;
+    };
+
+    /*!
+     * returns a checked out statement to the cache instead of deleting it
+     */
+    struct returner {
+      std::weak_ptr<storage> cache;
+      std::string sql;
+      std::shared_ptr<statement_type> owner;
+      unsigned long long generation;
+
+      void operator()(statement_type *) {
+        auto value = std::move(owner);
+
+        owner = nullptr;
+
+        auto s = cache.lock();
+
+        if (s) {
+          s->put(sql, value, generation);
+        }
+      }
+    };
+
+    explicit storage(size_t capacity) : capacity(capacity), hits(0), misses(0), generation(0) {}
+
+    static void finish(const std::vector<std::shared_ptr<statement_type>> &values) noexcept {
+      for (const auto &value : values) {
+        // outstanding results keep a busy statement alive until they are done
+        if (value->is_busy()) {
+          continue;
+        }
+        try {
+          value->finish();
+        } catch (...) {
+        }
+      }
+    }
+
+    /* must be called with the lock held */
+    void trim(size_t size, std::vector<std::shared_ptr<statement_type>> &evicted) {
+      while (lru.size() > size) {
+        auto &last = lru.back();
+        evicted.push_back(last.value);
+        index.erase(last.sql);
+        lru.pop_back();
+      }
+    }
+
+    void put(const std::string &sql, const std::shared_ptr<statement_type> &value, unsigned long long from) {
+      bool stale;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stale = from != generation;
+      }
+
+      // prepared on a connection that has since been closed
+      if (stale) {
+        finish({value});
+        return;
+      }
+
+      // release locks held by a partially stepped statement, unless results are still being read
+      if (!value->is_busy()) {
+        try {
+          value->reset();
+        } catch (...) {
+          finish({value});
+          return;
+        }
+      }
+
+      std::vector<std::shared_ptr<statement_type>> evicted;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (capacity == 0 || index.find(sql) != index.end()) {
+          // only one idle statement per sql
+          evicted.push_back(value);
+        } else {
+          lru.push_front({sql, value});
+          index[sql] = lru.begin();
+          trim(capacity, evicted);
+        }
+      }
+      finish(evicted);
+    }
+
+    std::shared_ptr<statement_type> take(const std::string &sql) {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      auto it = index.find(sql);
+
+      if (it == index.end() || it->second->value->is_busy()) {
+        misses++;
+        return nullptr;
+      }
+
+      auto value = it->second->value;
+
+      lru.erase(it->second);
+      index.erase(it);
+
+      hits++;
+
+      return value;
+    }
+
+    mutable std::mutex mutex;
+    size_t capacity;
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long generation;
+    std::list<entry> lru;
+    std::unordered_map<std::string, std::list<entry>::iterator> index;
+  };
+
+  statement_cache::statement_cache(size_t capacity) : storage_(make_shared<storage>(capacity)) {}
+
+  shared_ptr<statement_cache::statement_type> statement_cache::get(const string &sql, const factory_type &factory) {
+    auto value = storage_->take(sql);
+
+    if (value != nullptr) {
+      try {
+        value->reset();
+      } catch (...) {
+        storage::finish({value});
+        value = nullptr;
+      }
+    }
+
+    if (value == nullptr) {
+      value = factory(sql);
+    }
+
+    if (value == nullptr || capacity() == 0) {
+      return value;
+    }
+
+    auto raw = value.get();
+
+    unsigned long long generation;
+    {
+      std::lock_guard<std::mutex> lock(storage_->mutex);
+      generation = storage_->generation;
+    }
+
+    return shared_ptr<statement_type>(raw, storage::returner{storage_, sql, value, generation});
+  }
+
+  void statement_cache::clear() {
+    std::vector<std::shared_ptr<statement_type>> evicted;
+    {
+      std::lock_guard<std::mutex> lock(storage_->mutex);
+      storage_->trim(0, evicted);
+    }
+    storage::finish(evicted);
+  }
+
+  void statement_cache::invalidate() {
+    std::vector<std::shared_ptr<statement_type>> evicted;
+    {
+      std::lock_guard<std::mutex> lock(storage_->mutex);
+      storage_->generation++;
+      storage_->trim(0, evicted);
+    }
+    storage::finish(evicted);
+  }
+
+  size_t statement_cache::size() const {
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    return storage_->lru.size();
+  }
+
+  size_t statement_cache::capacity() const {
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    return storage_->capacity;
+  }
+
+  void statement_cache::set_capacity(size_t value) {
+    std::vector<std::shared_ptr<statement_type>> evicted;
+    {
+      std::lock_guard<std::mutex> lock(storage_->mutex);
+      storage_->capacity = value;
+      storage_->trim(value, evicted);
+    }
+    storage::finish(evicted);
+  }
+
+  unsigned long long statement_cache::hits() const {
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    return storage_->hits;
+  }
+
+  unsigned long long statement_cache::misses() const {
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    return storage_->misses;
+  }
+}  // namespace coda::db
@@ -0,0 +1,97 @@
+/*!
+ * @file statement_cache.h
+ * a cache of prepared statements
+ */
+#ifndef CODA_DB_STATEMENT_CACHE_H
+#define CODA_DB_STATEMENT_CACHE_H
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace coda::db {
+  class statement;
+
+  /*!
+   *  Statement cache keeps prepared statements keyed by their sql.
+   *  Statements are checked out exclusively and are returned to the cache
+   *  when the last reference is released.  The least recently used statement
+   *  is finished when the cache is full.
+   */
+  class statement_cache {
+   public:
+    using statement_type = statement;
+    using factory_type = std::function<std::shared_ptr<statement_type>(const std::string &sql)>;
+
+    /*!
+     * the default number of statements kept per session
+     */
+    static const size_t DEFAULT_CAPACITY = 32;
+
+    /*!
+     * @param capacity the maximum number of idle statements, zero to disable
+     */
+    explicit statement_cache(size_t capacity = DEFAULT_CAPACITY);
+
+    /* boilerplate, copies share the same storage */
+    statement_cache(const statement_cache &other) = default;
+    statement_cache(statement_cache &&other) noexcept = default;
+    ~statement_cache() = default;
+    statement_cache &operator=(const statement_cache &other) = default;
+    statement_cache &operator=(statement_cache &&other) noexcept = default;
+
+    /*!
+     * gets a reset statement for the sql, preparing one on a miss
+     * @param sql     the sql to prepare
+     * @param factory creates and prepares a statement on a miss
+     * @return the prepared statement
+     */
+    std::shared_ptr<statement_type> get(const std::string &sql, const factory_type &factory);
+
+    /*!
+     * finishes and removes all idle statements
+     */
+    void clear();
+
+    /*!
+     * finishes all idle statements, and statements checked out now are finished when
+     * they are returned instead of being cached.  used when the connection changes.
+     */
+    void invalidate();
+
+    /*!
+     * @return the number of idle statements
+     */
+    size_t size() const;
+
+    /*!
+     * @return the maximum number of idle statements
+     */
+    size_t capacity() const;
+
+    /*!
+     * @param value the maximum number of idle statements, zero to disable
+     */
+    void set_capacity(size_t value);
+
+    /*!
+     * @return the number of times a statement was reused
+     */
+    unsigned long long hits() const;
+
+    /*!
+     * @return the number of times a statement was prepared
+     */
+    unsigned long long misses() const;
+
+   private:
+    struct storage;
+
+    std::shared_ptr<storage> storage_;
+  };
+}  // namespace coda::db
+
+#endif
@@ -0,0 +1,195 @@
+#include "unicode.h"
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace coda::db::helper {
+  namespace {
+    constexpr static const char32_t REPLACEMENT = 0xFFFD;
+
+    template<typename C>
+    using code_unit = std::make_unsigned_t<C>;
+
+    /**
+     * finds the end of a run of ascii, testing a word at a time
+     */
+    template<typename C>
+    const C *ascii_run(const C *it, const C *end) noexcept {
+      constexpr size_t per_word = sizeof(uint64_t) / sizeof(C);
+      constexpr uint64_t unit = ~0ULL >> (64 - 8 * sizeof(C));
+      // the bits above ascii in every code unit of a word
+      constexpr uint64_t mask = (~0ULL / unit) * (unit & ~0x7FULL);
+
+      while (static_cast<size_t>(end - it) >= per_word) {
+        uint64_t word;
+        memcpy(&word, it, sizeof(word));
+        if (word & mask) {
+          break;
+        }
+        it += per_word;
+      }
+      while (it < end && static_cast<code_unit<C>>(*it) < 0x80) {
+        it++;
+      }
+      return it;
+    }
+
+    /**
+     * reads a code point from UTF-8, consuming only the lead byte of a malformed sequence
+     */
+    char32_t decode_utf8(const unsigned char *&it, const unsigned char *end) noexcept {
+      auto lead = *it++;
+      size_t size;
+      char32_t value, min;
+
+      if ((lead & 0xE0) == 0xC0) {
+        size = 1;
+        value = lead & 0x1F;
+        min = 0x80;
+      } else if ((lead & 0xF0) == 0xE0) {
+        size = 2;
+        value = lead & 0x0F;
+        min = 0x800;
+      } else if ((lead & 0xF8) == 0xF0) {
+        size = 3;
+        value = lead & 0x07;
+        min = 0x10000;
+      } else {
+        return REPLACEMENT;
+      }
+
+      if (static_cast<size_t>(end - it) < size) {
+        return REPLACEMENT;
+      }
+
+      for (size_t i = 0; i < size; i++) {
+        if ((it[i] & 0xC0) != 0x80) {
+          return REPLACEMENT;
+        }
+        value = (value << 6) | (it[i] & 0x3F);
+      }
+
+      it += size;
+
+      // overlong encodings, surrogates and values past the last plane
+      if (value < min || value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF)) {
+        return REPLACEMENT;
+      }
+      return value;
+    }
+
+    /**
+     * reads a code point from UTF-16 or UTF-32
+     */
+    template<typename C>
+    char32_t decode_wide(const C *&it, const C *end) noexcept {
+      char32_t value = static_cast<code_unit<C>>(*it++);
+
+      if constexpr (sizeof(C) == 2) {
+        if (value >= 0xD800 && value <= 0xDBFF && it < end) {
+          char32_t low = static_cast<code_unit<C>>(*it);
+          if (low >= 0xDC00 && low <= 0xDFFF) {
+            it++;
+            return 0x10000 + ((value - 0xD800) << 10) + (low - 0xDC00);
+          }
+        }
+      }
+
+      if (value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF)) {
+        return REPLACEMENT;
+      }
+      return value;
+    }
+
+    char *encode_utf8(char *out, char32_t value) noexcept {
+      if (value < 0x80) {
+        *out++ = static_cast<char>(value);
+      } else if (value < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (value >> 6));
+        *out++ = static_cast<char>(0x80 | (value & 0x3F));
+      } else if (value < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (value >> 12));
+        *out++ = static_cast<char>(0x80 | ((value >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (value & 0x3F));
+      } else {
+        *out++ = static_cast<char>(0xF0 | (value >> 18));
+        *out++ = static_cast<char>(0x80 | ((value >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((value >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (value & 0x3F));
+      }
+      return out;
+    }
+
+    template<typename C>
+    C *encode_wide(C *out, char32_t value) noexcept {
+      if constexpr (sizeof(C) == 2) {
+        if (value >= 0x10000) {
+          value -= 0x10000;
+          *out++ = static_cast<C>(0xD800 + (value >> 10));
+          *out++ = static_cast<C>(0xDC00 + (value & 0x3FF));
+          return out;
+        }
+      }
+      *out++ = static_cast<C>(value);
+      return out;
+    }
+
+    template<typename C>
+    std::string to_utf8(const C *it, const C *end) {
+      std::string out;
+
+      // a UTF-16 unit is at most three bytes, a UTF-32 unit at most four
+      out.resize(static_cast<size_t>(end - it) * (sizeof(C) == 2 ? 3 : 4));
+
+      auto pos = &out[0];
+
+      while (it < end) {
+        for (auto run = ascii_run(it, end); it < run; it++) {
+          *pos++ = static_cast<char>(*it);
+        }
+        if (it < end) {
+          pos = encode_utf8(pos, decode_wide(it, end));
+        }
+      }
+
+      out.resize(static_cast<size_t>(pos - out.data()));
+      return out;
+    }
+
+    template<typename S>
+    S from_utf8(std::string_view value) {
+      S out;
+      auto it = reinterpret_cast<const unsigned char *>(value.data());
+      auto end = it + value.size();
+
+      // a code unit never needs more than one byte
+      out.resize(value.size());
+
+      auto pos = &out[0];
+
+      while (it < end) {
+        for (auto run = ascii_run(it, end); it < run; it++) {
+          *pos++ = static_cast<typename S::value_type>(*it);
+        }
+        if (it < end) {
+          pos = encode_wide(pos, decode_utf8(it, end));
+        }
+      }
+
+      out.resize(static_cast<size_t>(pos - out.data()));
+      return out;
+    }
+  }  // namespace
+
+  std::string to_utf8(std::wstring_view value) { return to_utf8(value.data(), value.data() + value.size()); }
+
+  std::string to_utf8(std::u16string_view value) { return to_utf8(value.data(), value.data() + value.size()); }
+
+  std::string to_utf8(std::u32string_view value) { return to_utf8(value.data(), value.data() + value.size()); }
+
+  std::wstring utf8_to_wide(std::string_view value) { return from_utf8<std::wstring>(value); }
+
+  std::u16string utf8_to_utf16(std::string_view value) { return from_utf8<std::u16string>(value); }
+
+  std::u32string utf8_to_utf32(std::string_view value) { return from_utf8<std::u32string>(value); }
+}  // namespace coda::db::helper
@@ -0,0 +1,51 @@
+/*!
+ * @file unicode.h
+ * @abstract Transcoding between UTF-8 and wide strings
+ * @discussion Runs of ascii are copied a word at a time. Invalid sequences are replaced with U+FFFD instead of
+ * throwing, so conversions never fail.
+ */
+#ifndef CODA_DB_UNICODE_H
+#define CODA_DB_UNICODE_H
+
+#include <string>
+#include <string_view>
+
+namespace coda::db::helper {
+  /*!
+   * @param value wide text, UTF-32 or UTF-16 depending on the size of wchar_t
+   * @return the text as UTF-8
+   */
+  std::string to_utf8(std::wstring_view value);
+
+  /*!
+   * @param value UTF-16 text
+   * @return the text as UTF-8
+   */
+  std::string to_utf8(std::u16string_view value);
+
+  /*!
+   * @param value UTF-32 text
+   * @return the text as UTF-8
+   */
+  std::string to_utf8(std::u32string_view value);
+
+  /*!
+   * @param value UTF-8 text
+   * @return the text as a wide string, UTF-32 or UTF-16 depending on the size of wchar_t
+   */
+  std::wstring utf8_to_wide(std::string_view value);
+
+  /*!
+   * @param value UTF-8 text
+   * @return the text as UTF-16
+   */
+  std::u16string utf8_to_utf16(std::string_view value);
+
+  /*!
+   * @param value UTF-8 text
+   * @return the text as UTF-32
+   */
+  std::u32string utf8_to_utf32(std::string_view value);
+}  // namespace coda::db::helper
+
+#endif
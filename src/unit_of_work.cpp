@@ -0,0 +1,324 @@
+#include "unit_of_work.h"
+#include <algorithm>
+#include "delete_query.h"
+#include "exception.h"
+#include "insert_query.h"
+#include "session.h"
+#include "transaction.h"
+#include "update_query.h"
+
+namespace coda::db {
+  namespace {
+    /**
+     * adds the schemas of records in the order they are first seen
+     */
+    void add_schemas(const std::vector<unit_of_work::record_type> &records,
+                     std::vector<std::shared_ptr<schema>> &schemas) {
+      for (auto &record : records) {
+        auto schema = record->schema();
+
+        if (std::find(schemas.begin(), schemas.end(), schema) == schemas.end()) {
+          schemas.push_back(schema);
+        }
+      }
+    }
+
+    /**
+     * a record is inserted unless it was loaded or saved with the same key
+     */
+    bool is_new(const unit_of_work::record_type &record, const std::string &pk) {
+      return !record->is_persisted() || !record->has(pk) || record->is_dirty(pk);
+    }
+
+    /**
+     * removes a record from a list, if it is there
+     */
+    void erase(std::vector<unit_of_work::record_type> &records, const unit_of_work::record_type &value) {
+      records.erase(std::remove(records.begin(), records.end(), value), records.end());
+    }
+
+    /**
+     * a save point in a transaction the caller started, rolled back unless it is released
+     */
+    class save_point {
+     public:
+      constexpr static const char *const NAME = "coda_unit_of_work";
+
+      explicit save_point(const std::shared_ptr<session> &session) : session_(session), released_(false) {
+        if (!session_->impl()->execute(std::string("SAVEPOINT ") + NAME + ";")) {
+          throw transaction_exception("unable to save point " + std::string(NAME) + ": " + session_->last_error());
+        }
+      }
+
+      save_point(const save_point &other) = delete;
+
+      ~save_point() {
+        if (!released_) {
+          session_->impl()->execute(std::string("ROLLBACK TO SAVEPOINT ") + NAME + ";");
+          session_->impl()->execute(std::string("RELEASE SAVEPOINT ") + NAME + ";");
+        }
+      }
+
+      save_point &operator=(const save_point &other) = delete;
+
+      void release() {
+        if (!session_->impl()->execute(std::string("RELEASE SAVEPOINT ") + NAME + ";")) {
+          throw transaction_exception("unable to release save point " + std::string(NAME) + ": " +
+                                      session_->last_error());
+        }
+        released_ = true;
+      }
+
+     private:
+      std::shared_ptr<session> session_;
+      bool released_;
+    };
+  }  // namespace
+
+  unit_of_work::unit_of_work(const std::shared_ptr<coda::db::session> &session) : session_(session) {
+    if (session_ == nullptr) {
+      throw database_exception("no session for unit of work");
+    }
+  }
+
+  unit_of_work &unit_of_work::save(const record_type &value) {
+    if (value == nullptr) {
+      throw database_exception("no record to save");
+    }
+
+    erase(removed_, value);
+
+    if (std::find(saved_.begin(), saved_.end(), value) == saved_.end()) {
+      saved_.push_back(value);
+    }
+    return *this;
+  }
+
+  unit_of_work &unit_of_work::remove(const record_type &value) {
+    if (value == nullptr) {
+      throw database_exception("no record to remove");
+    }
+
+    erase(saved_, value);
+
+    if (std::find(removed_.begin(), removed_.end(), value) == removed_.end()) {
+      removed_.push_back(value);
+    }
+    return *this;
+  }
+
+  const identity_map &unit_of_work::identities() const noexcept { return identities_; }
+
+  size_t unit_of_work::size() const noexcept { return saved_.size() + removed_.size(); }
+
+  void unit_of_work::clear() noexcept {
+    saved_.clear();
+    removed_.clear();
+  }
+
+  sql_changes unit_of_work::flush() {
+    if (saved_.empty() && removed_.empty()) {
+      return 0;
+    }
+
+    std::vector<std::shared_ptr<schema>> schemas;
+
+    add_schemas(saved_, schemas);
+    add_schemas(removed_, schemas);
+
+    sql_changes changes = 0;
+    generated_ids ids;
+
+    auto write = [&]() {
+      for (auto &schema : schemas) {
+        changes += flush_inserts(schema, ids);
+        changes += flush_updates(schema);
+        changes += flush_deletes(schema);
+      }
+    };
+
+    if (session_->in_transaction()) {
+      // joins the caller's transaction, only undoing this flush when a statement throws
+      save_point point(session_);
+
+      write();
+
+      point.release();
+    } else {
+      // rolls back when a statement throws
+      auto tx = session_->start_transaction();
+
+      write();
+
+      tx.commit();
+    }
+
+    // records only change once the transaction is committed
+    for (auto &id : ids) {
+      id.first->set(id.first->schema()->primary_key(), id.second);
+    }
+
+    for (auto &record : saved_) {
+      record->mark_clean();
+      identities_.put(record);
+    }
+
+    for (auto &record : removed_) {
+      auto schema = record->schema();
+      auto id = record->get(schema->primary_key());
+
+      record->persisted_ = false;
+      identities_.erase(*schema, id);
+      record_cache::global().erase(*schema, id);
+    }
+
+    clear();
+
+    return changes;
+  }
+
+  sql_changes unit_of_work::flush_inserts(const std::shared_ptr<schema> &schema, generated_ids &ids) {
+    auto pk = schema->primary_key();
+
+    // records with the same columns share a statement
+    std::vector<std::pair<std::vector<std::string>, std::vector<record_type>>> groups;
+
+    for (auto &record : saved_) {
+      if (record->schema() != schema || !is_new(record, pk)) {
+        continue;
+      }
+
+      auto columns = record->available_columns(record->has(pk), pk);
+
+      auto group = std::find_if(groups.begin(), groups.end(), [&columns](const auto &value) {
+        return value.first == columns;
+      });
+
+      if (group == groups.end()) {
+        groups.emplace_back(columns, std::vector<record_type>{record});
+      } else {
+        group->second.push_back(record);
+      }
+    }
+
+    sql_changes changes = 0;
+
+    for (auto &group : groups) {
+      auto &columns = group.first;
+      auto &records = group.second;
+      auto generated = std::find(columns.begin(), columns.end(), pk) == columns.end();
+
+      insert_query query(schema, columns);
+
+      // a record with a key may already exist, as save() would have checked
+      if (!generated && (session_->has_feature(session::FEATURE_ON_CONFLICT) ||
+                         session_->has_feature(session::FEATURE_ON_DUPLICATE_KEY))) {
+        query.on_conflict();
+      }
+
+      // the generated keys of a multi-row insert can only be read back with RETURNING
+      if (generated && !session_->has_feature(session::FEATURE_RETURNING)) {
+        for (auto &record : records) {
+          query.bind(record->get(columns));
+
+          if (query.execute() == 0) {
+            throw database_exception("unable to insert record: " + session_->last_error());
+          }
+
+          ids.emplace_back(record, query.last_insert_id());
+          changes++;
+        }
+        continue;
+      }
+
+      for (auto &record : records) {
+        query.add_row(record->get(columns));
+      }
+
+      changes += query.execute();
+
+      if (generated) {
+        auto keys = query.last_insert_ids();
+
+        if (keys.size() != records.size()) {
+          throw database_exception("unable to read the keys of inserted records");
+        }
+
+        for (size_t i = 0; i < keys.size(); i++) {
+          ids.emplace_back(records[i], keys[i]);
+        }
+      }
+    }
+
+    return changes;
+  }
+
+  sql_changes unit_of_work::flush_updates(const std::shared_ptr<schema> &schema) {
+    auto pk = schema->primary_key();
+    sql_changes changes = 0;
+
+    for (auto &record : saved_) {
+      if (record->schema() != schema || is_new(record, pk)) {
+        continue;
+      }
+
+      auto columns = record->dirty_columns(pk);
+
+      if (columns.empty()) {
+        continue;
+      }
+
+      // the sql is the same for records with the same changes, so the session reuses the statement
+      update_query query(schema, columns);
+
+      query.bind(record->get(columns));
+
+      query.where(op::equals(pk, record->get(pk)));
+
+      changes += query.execute();
+    }
+
+    return changes;
+  }
+
+  sql_changes unit_of_work::flush_deletes(const std::shared_ptr<schema> &schema) {
+    auto pk = schema->primary_key();
+    std::vector<sql_value> keys;
+
+    for (auto &record : removed_) {
+      if (record->schema() == schema && record->has(pk)) {
+        keys.push_back(record->get(pk));
+      }
+    }
+
+    auto impl = session_->impl();
+    auto perStatement = std::max<size_t>(1, session_->max_bind_params());
+    sql_changes changes = 0;
+
+    for (size_t offset = 0; offset < keys.size(); offset += perStatement) {
+      auto count = std::min(perStatement, keys.size() - offset);
+
+      std::string sql = pk + " IN (";
+
+      for (size_t i = 1; i <= count; i++) {
+        if (i > 1) {
+          sql += ",";
+        }
+        sql += impl->bind_param(i);
+      }
+
+      sql += ")";
+
+      delete_query query(schema);
+
+      query.where(where_clause(sql));
+
+      query.bind(std::vector<sql_value>(keys.begin() + static_cast<long>(offset),
+                                        keys.begin() + static_cast<long>(offset + count)));
+
+      changes += query.execute();
+    }
+
+    return changes;
+  }
+}  // namespace coda::db
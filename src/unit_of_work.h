@@ -0,0 +1,110 @@
+/*!
+ * @file unit_of_work.h
+ * batches record changes into a single transaction
+ */
+#ifndef CODA_DB_UNIT_OF_WORK_H
+#define CODA_DB_UNIT_OF_WORK_H
+
+#include <memory>
+#include <vector>
+#include "record.h"
+#include "sql_types.h"
+
+namespace coda::db {
+  class session;
+
+  /*!
+   * collects new, changed and deleted records and writes them together.
+   * records are grouped by schema so rows with the same columns are written with multi-row statements.
+   * records found or saved through a unit of work are kept in an identity map, so finding the same id
+   * again returns the same instance without a query.
+   */
+  class unit_of_work {
+   public:
+    using record_type = std::shared_ptr<base::record>;
+
+    /*!
+     * @param session the session the records belong to
+     */
+    explicit unit_of_work(const std::shared_ptr<coda::db::session> &session);
+
+    unit_of_work(const unit_of_work &other) = default;
+
+    unit_of_work(unit_of_work &&other) noexcept = default;
+
+    ~unit_of_work() = default;
+
+    unit_of_work &operator=(const unit_of_work &other) = default;
+
+    unit_of_work &operator=(unit_of_work &&other) noexcept = default;
+
+    /*!
+     * adds a record to insert if it is new, or to update if it has changed
+     * @param value the record to save
+     * @return a reference to this instance
+     */
+    unit_of_work &save(const record_type &value);
+
+    /*!
+     * adds a record to delete by its primary key
+     * @param value the record to remove
+     * @return a reference to this instance
+     */
+    unit_of_work &remove(const record_type &value);
+
+    /*!
+     * finds a record by id, returning the instance already loaded by this unit of work if there is one
+     * @param schema the schema to find
+     * @param value the value of the id to find
+     * @return the record or nullptr
+     */
+    template<typename T, typename = std::enable_if<std::is_base_of<base::record, T>::value>>
+    std::shared_ptr<T> find_by_id(const std::shared_ptr<schema> &schema, const sql_value &value) {
+      auto found = std::dynamic_pointer_cast<T>(identities_.get(*schema, value));
+
+      if (found == nullptr) {
+        found = coda::db::find_by_id<T>(schema, value);
+        identities_.put(found);
+      }
+      return found;
+    }
+
+    /*!
+     * @return the records loaded by this unit of work
+     */
+    const identity_map &identities() const noexcept;
+
+    /*!
+     * @return the number of records waiting to be flushed
+     */
+    size_t size() const noexcept;
+
+    /*!
+     * forgets the records waiting to be flushed
+     */
+    void clear() noexcept;
+
+    /*!
+     * writes the records in a single transaction: inserts, then updates, then deletes for each schema.
+     * the transaction is rolled back and the records are left unchanged if any statement fails.
+     * inside a transaction the caller started, the flush is written to a save point in that transaction instead,
+     * and the records are updated without waiting for the caller to commit.
+     * @return the number of rows changed
+     */
+    sql_changes flush();
+
+   private:
+    typedef std::vector<std::pair<record_type, sql_value>> generated_ids;
+
+    sql_changes flush_inserts(const std::shared_ptr<schema> &schema, generated_ids &ids);
+    sql_changes flush_updates(const std::shared_ptr<schema> &schema);
+    sql_changes flush_deletes(const std::shared_ptr<schema> &schema);
+
+    std::shared_ptr<coda::db::session> session_;
+    std::vector<record_type> saved_;
+    std::vector<record_type> removed_;
+    identity_map identities_;
+  };
+}  // namespace coda::db
+
+#endif
@@ -98,25 +98,21 @@ namespace coda::db {
 
   update_query &update_query::values(const std::vector<sql_value> &value) {
     bindable::bind(value);
-    set_modified();
     return *this;
   }
 
   update_query &update_query::values(const std::unordered_map<std::string, sql_value> &value) {
     bindable::bind(value);
-    set_modified();
     return *this;
   }
 
   update_query &update_query::value(const std::string &name, const sql_value &value) {
     bind(name, value);
-    set_modified();
     return *this;
   }
 
   update_query &update_query::value(const sql_value &value) {
     bind(num_of_bindings() + 1, value);
-    set_modified();
     return *this;
   }
 }  // namespace coda::db
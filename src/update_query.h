@@ -138,7 +138,6 @@ namespace coda::db {
     template<typename T, typename... List>
     update_query &values(const T &value, const List &... argv) {
       bind_list(1, value, argv...);
-      set_modified();
       return *this;
     }
 
@@ -1,5 +1,6 @@
 
 #include "where_clause.h"
+#include "query.h"
 #include "session.h"
 
 using namespace std;
@@ -398,7 +399,7 @@ namespace coda::db {
     return out;
   }
 
-  where_builder::where_builder(const std::shared_ptr<session_impl> &session, bindable *binder)
+  where_builder::where_builder(const std::shared_ptr<session_impl> &session, query *binder)
       : session_(session), binder_(binder) {}
 
   where_builder::where_builder(const where_builder &other)
@@ -473,6 +474,7 @@ namespace coda::db {
   void where_builder::reset(const sql_operator &value) {
     size_t index = binder_->num_of_bindings() + 1;
     where_clause::reset(to_sql(index, value));
+    binder_->set_modified();
     bind(index, value);
   }
 
@@ -485,6 +487,8 @@ namespace coda::db {
   where_builder &where_builder::operator&&(const sql_operator &value) {
     size_t index = binder_->num_of_bindings() + 1;
     where_clause::operator&&(to_sql(index, value));
+    // the query sql changes along with the where clause
+    binder_->set_modified();
     return bind(index, value);
   }
 
@@ -495,6 +499,8 @@ namespace coda::db {
   where_builder &where_builder::operator||(const sql_operator &value) {
     size_t index = binder_->num_of_bindings() + 1;
     where_clause::operator&&(to_sql(index, value));
+    // the query sql changes along with the where clause
+    binder_->set_modified();
     return bind(index, value);
   }
 }  // namespace coda::db
@@ -14,6 +14,7 @@
 namespace coda::db {
   class session_impl;
   class sql_operator;
+  class query;
 
   typedef struct {
     std::string name;
@@ -223,7 +224,7 @@ namespace coda::db {
 
   class where_builder : public where_clause, public bindable {
    private:
-    bindable *binder_;
+    query *binder_;
     std::shared_ptr<session_impl> session_;
 
     where_builder &bind(size_t index, const sql_operator &value);
@@ -234,7 +235,7 @@ namespace coda::db {
     where_builder &bind(const std::string &name, const sql_value &value) override;
 
    public:
-    where_builder(const std::shared_ptr<session_impl> &session, bindable *bindable);
+    where_builder(const std::shared_ptr<session_impl> &session, query *query);
     where_builder(const where_builder &other);
     where_builder(where_builder &&other) noexcept;
     where_builder &operator=(const where_builder &other);
@@ -0,0 +1,93 @@
+#include <string>
+#include <vector>
+#include "number_format.h"
+#include "util.h"
+#include <benchpress/benchpress.hpp>
+
+using namespace coda::db;
+
+namespace {
+  constexpr static const size_t NUMBER_COUNT = 1000;
+
+  std::vector<double> random_reals() {
+    std::vector<double> values;
+
+    for (size_t i = 0; i < NUMBER_COUNT; i++) {
+      values.push_back(random_num<int>(-1000000, 1000000) / 1000.0);
+    }
+    return values;
+  }
+
+  std::vector<std::string> random_text() {
+    std::vector<std::string> values;
+
+    for (auto value : random_reals()) {
+      values.push_back(helper::format_number(value));
+    }
+    return values;
+  }
+
+  volatile size_t sink = 0;
+}  // namespace
+
+BENCHMARK("format numbers with to_chars", [](benchpress::context *context) {
+  auto values = random_reals();
+
+  context->reset_timer();
+
+  for (size_t i = 0; i < context->num_iterations(); i++) {
+    for (auto value : values) {
+      sink = sink + helper::format_number(value).size();
+    }
+  }
+
+  context->stop_timer();
+});
+
+BENCHMARK("format numbers with to_string", [](benchpress::context *context) {
+  auto values = random_reals();
+
+  context->reset_timer();
+
+  for (size_t i = 0; i < context->num_iterations(); i++) {
+    for (auto value : values) {
+      sink = sink + std::to_string(value).size();
+    }
+  }
+
+  context->stop_timer();
+});
+
+BENCHMARK("parse numbers with from_chars", [](benchpress::context *context) {
+  auto values = random_text();
+
+  context->reset_timer();
+
+  for (size_t i = 0; i < context->num_iterations(); i++) {
+    for (const auto &value : values) {
+      double number = 0;
+      if (helper::parse_number(value, number)) {
+        sink = sink + static_cast<size_t>(number != 0);
+      }
+    }
+  }
+
+  context->stop_timer();
+});
+
+BENCHMARK("parse numbers with stod", [](benchpress::context *context) {
+  auto values = random_text();
+
+  context->reset_timer();
+
+  for (size_t i = 0; i < context->num_iterations(); i++) {
+    for (const auto &value : values) {
+      try {
+        sink = sink + static_cast<size_t>(std::stod(value) != 0);
+      } catch (const std::exception &e) {
+      }
+    }
+  }
+
+  context->stop_timer();
+});
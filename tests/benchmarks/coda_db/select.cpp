@@ -95,3 +95,25 @@ postgres_teardown();
 
 benchmark_teardown();
 });
+
+BENCHMARK("sqlite load records", [](benchpress::context *context) {
+  uri uri_s("file://test.db");
+
+  benchmark_setup(uri_s);
+
+  sqlite_setup();
+
+  benchmark_populate(context);
+
+  context->reset_timer();
+
+  auto records = user().find_all();
+
+  context->stop_timer();
+
+  assert(records.size() == context->num_iterations());
+
+  sqlite_teardown();
+
+  benchmark_teardown();
+});
@@ -0,0 +1,78 @@
+#include <codecvt>
+#include <locale>
+#include <string>
+#include "unicode.h"
+#include <benchpress/benchpress.hpp>
+
+using namespace coda::db;
+
+namespace {
+  const std::string ascii_text =
+      "The quick brown fox jumps over the lazy dog, then files a report about it in plain ascii text.";
+
+  const std::string multilingual_text =
+      u8"Ünïcödé tëxt – 日本語のテキスト, Русский текст, ελληνικό κείμενο and some emoji 🎉🚀 mixed in.";
+
+  std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> &converter() {
+    static std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> value;
+    return value;
+  }
+
+  volatile size_t sink = 0;
+
+  void benchmark_to_wide(benchpress::context *context, const std::string &text, bool transcoder) {
+    context->reset_timer();
+
+    for (size_t i = 0; i < context->num_iterations(); i++) {
+      auto wide = transcoder ? helper::utf8_to_wide(text) : converter().from_bytes(text);
+      sink = sink + wide.size();
+    }
+
+    context->stop_timer();
+  }
+
+  void benchmark_to_utf8(benchpress::context *context, const std::string &text, bool transcoder) {
+    auto wide = helper::utf8_to_wide(text);
+
+    context->reset_timer();
+
+    for (size_t i = 0; i < context->num_iterations(); i++) {
+      auto narrow = transcoder ? helper::to_utf8(wide) : converter().to_bytes(wide);
+      sink = sink + narrow.size();
+    }
+
+    context->stop_timer();
+  }
+}  // namespace
+
+BENCHMARK("ascii to wide with transcoder", [](benchpress::context *context) {
+  benchmark_to_wide(context, ascii_text, true);
+});
+
+BENCHMARK("ascii to wide with wstring_convert", [](benchpress::context *context) {
+  benchmark_to_wide(context, ascii_text, false);
+});
+
+BENCHMARK("multilingual to wide with transcoder", [](benchpress::context *context) {
+  benchmark_to_wide(context, multilingual_text, true);
+});
+
+BENCHMARK("multilingual to wide with wstring_convert", [](benchpress::context *context) {
+  benchmark_to_wide(context, multilingual_text, false);
+});
+
+BENCHMARK("ascii to utf8 with transcoder", [](benchpress::context *context) {
+  benchmark_to_utf8(context, ascii_text, true);
+});
+
+BENCHMARK("ascii to utf8 with wstring_convert", [](benchpress::context *context) {
+  benchmark_to_utf8(context, ascii_text, false);
+});
+
+BENCHMARK("multilingual to utf8 with transcoder", [](benchpress::context *context) {
+  benchmark_to_utf8(context, multilingual_text, true);
+});
+
+BENCHMARK("multilingual to utf8 with wstring_convert", [](benchpress::context *context) {
+  benchmark_to_utf8(context, multilingual_text, false);
+});
@@ -111,5 +111,90 @@ specification(modifying, []() {
 
       Assert::That(count, Equals(5));
     });
+
+    it("prepares once when only values change", []() {
+      insert_query query(test::current_session, test::user::TABLE_NAME, {"first_name", "last_name"});
+
+      auto &statements = test::current_session->statements();
+
+      auto lookups = statements.hits() + statements.misses();
+
+      for (int i = 0; i < 5; i++) {
+        query.values("first" + std::to_string(i), "last" + std::to_string(i));
+
+        Assert::That(query.execute(), Equals(1));
+      }
+
+      // a cache hit would also mean the statement was requested again
+      Assert::That(statements.hits() + statements.misses() - lookups, Equals(1));
+
+      test::user u1(query.last_insert_id());
+
+      Assert::That(u1.get("first_name"), Equals("first4"));
+    });
+
+    it("can insert multiple rows", []() {
+      insert_query query(test::current_session, test::user::TABLE_NAME, {"first_name", "last_name"});
+
+      auto limit = test::current_session->max_bind_params();
+
+      // enough rows to need more than one statement
+      auto rows = limit / 2 + 10;
+
+      for (size_t i = 0; i < rows; i++) {
+        query.add_row("first" + std::to_string(i), "last" + std::to_string(i));
+      }
+
+      query.values_batch({{"Bryan", "Jenkins"}, {"Bob", "Smith"}});
+
+      Assert::That(query.num_of_rows(), Equals(rows + 2));
+
+      Assert::That(query.execute(), Equals(rows + 2));
+
+      Assert::That(query.num_of_rows(), Equals(0));
+
+      if (test::current_session->has_feature(session::FEATURE_RETURNING)) {
+        Assert::That(query.last_insert_ids().size(), Equals(rows + 2));
+      }
+
+      select_query select(test::current_session);
+
+      Assert::That(select.from(test::user::TABLE_NAME).count(), Equals(rows + 4));
+    });
+
+    it("requires a value for each column in a row", []() {
+      insert_query query(test::current_session, test::user::TABLE_NAME, {"first_name", "last_name"});
+
+      query.add_row("Bryan");
+
+      AssertThrows(binding_error, query.execute());
+    });
+
+    it("can update on conflict", []() {
+      test::user user1;
+
+      user1.set("first_name", "Conflict");
+      user1.set("last_name", "Free");
+
+      Assert::That(user1.save(), IsTrue());
+
+      insert_query query(test::current_session, test::user::TABLE_NAME, {"id", "first_name"});
+
+      query.on_conflict();
+
+      query.values(user1.id(), "Conflicted");
+
+      Assert::That(query.execute() > 0, IsTrue());
+
+      Assert::That(user1.refresh(), IsTrue());
+
+      Assert::That(user1.get("first_name"), Equals("Conflicted"));
+
+      Assert::That(user1.get("last_name"), Equals("Free"));
+
+      select_query select(test::current_session);
+
+      Assert::That(select.from(test::user::TABLE_NAME).count(), Equals(3));
+    });
   });
 });
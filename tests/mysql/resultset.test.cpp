@@ -2,6 +2,7 @@
 
 #include "../db.test.h"
 #include "mysql/resultset.h"
+#include "mysql/session.h"
 #include <bandit/bandit.h>
 
 using namespace bandit;
@@ -106,6 +107,41 @@ SPEC_BEGIN(mysql_resultset) {
 
       AssertThrows(database_exception, query.execute());
     });
+
+    it("can stream results", []() {
+      auto sess = dynamic_pointer_cast<mysql::session>(test::current_session->impl());
+
+      auto rs = sess->query("select * from users", true);
+
+      Assert::That(rs->next(), IsTrue());
+
+      AssertThrows(database_exception, sess->query("select * from users"));
+
+      AssertThrows(database_exception, rs->reset());
+
+      int count = 1;
+
+      while (rs->next()) {
+        count++;
+      }
+
+      Assert::That(count, Equals(2));
+
+      // the connection is free once the last row is read
+      Assert::That(sess->query("select * from users")->next(), IsTrue());
+    });
+
+    it("releases the connection when streaming results are discarded", []() {
+      auto sess = dynamic_pointer_cast<mysql::session>(test::current_session->impl());
+
+      {
+        auto rs = sess->query("select * from users", true);
+
+        Assert::That(rs->next(), IsTrue());
+      }
+
+      Assert::That(sess->execute("select 1"), IsTrue());
+    });
   });
 }
 SPEC_END;
@@ -57,6 +57,30 @@ SPEC_BEGIN(mysql_statement) {
       AssertThrows(database_exception, other.prepare("select * from users"));
     });
 
+    it("can fetch values larger than the result buffer", []() {
+      mysql::statement stmt(dynamic_pointer_cast<mysql::session>(test::current_session->impl()));
+
+      stmt.prepare("select repeat('x', ?), first_name from users order by id");
+
+      for (auto size : {100000, 10}) {
+        stmt.bind(1, size);
+
+        auto rs = stmt.query();
+
+        int count = 0;
+
+        for (auto &row : rs) {
+          Assert::That(row.column(0).value().to_string().size(), Equals(static_cast<size_t>(size)));
+          Assert::That(row.column(1).value().to_string().empty(), IsFalse());
+          count++;
+        }
+
+        Assert::That(count, Equals(2));
+
+        stmt.reset();
+      }
+    });
+
     it("can handle an error", []() {
       auto db = create_session("mysql://xxxxxx/yyyyyy");
 
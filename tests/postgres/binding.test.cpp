@@ -2,6 +2,8 @@
 
 #include "../db.test.h"
 #include "postgres/binding.h"
+#include <postgres.h>
+#include <catalog/pg_type.h>
 #include <bandit/bandit.h>
 
 using namespace bandit;
@@ -96,6 +98,29 @@ SPEC_BEGIN(postgres_binding) {
 
       Assert::That(c.to_value(0), Equals(24));
     });
+
+    it("binds numbers in binary", []() {
+      postgres::binding b;
+
+      b.bind(1, 24);
+      b.bind(2, 1.5);
+      b.bind(3, 1234567890123LL);
+      b.bind(4, true);
+
+      Assert::That(b.sql_type(0), Equals(INT4OID));
+      Assert::That(b.sql_type(1), Equals(FLOAT8OID));
+
+      Assert::That(b.to_value(0), Equals(24));
+      Assert::That(b.to_value(1), Equals(1.5));
+      Assert::That(b.to_value(2), Equals(1234567890123LL));
+      Assert::That(b.to_value(3), Equals(true));
+
+      select_query query(test::current_session, {}, test::user::TABLE_NAME);
+
+      query.where(op::equals("id", 3)) && op::greater("dval", 3.0);
+
+      Assert::That(query.count(), Equals(1));
+    });
   });
 }
 SPEC_END;
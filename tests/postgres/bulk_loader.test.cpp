@@ -0,0 +1,95 @@
+#include <string>
+
+#include "../db.test.h"
+#include "postgres/bulk_loader.h"
+#include "postgres/session.h"
+#include "select_query.h"
+#include <bandit/bandit.h>
+
+using namespace bandit;
+
+using namespace std;
+
+using namespace coda::db;
+
+using namespace snowhouse;
+
+SPEC_BEGIN(postgres_bulk_loader) {
+  describe("postgres bulk loader", []() {
+    before_each([]() { test::setup_current_session(); });
+
+    after_each([]() { test::teardown_current_session(); });
+
+    it("can load text rows", []() {
+      postgres::bulk_loader loader(dynamic_pointer_cast<postgres::session>(test::current_session->impl()),
+                                   test::user::TABLE_NAME, {"first_name", "last_name", "dval"});
+
+      for (int i = 0; i < 1000; i++) {
+        loader.add_row("Bryan", "Jenkins\twith\\escapes", i);
+      }
+
+      loader.add_row("Mark", sql_null, 1.5);
+
+      AssertThat(loader.finish(), Equals(1001));
+
+      select_query query(test::current_session, {}, test::user::TABLE_NAME);
+
+      query.where(op::equals("last_name", "Jenkins\twith\\escapes"));
+
+      AssertThat(query.count(), Equals(1000));
+    });
+
+    it("can load binary rows", []() {
+      postgres::bulk_loader loader(dynamic_pointer_cast<postgres::session>(test::current_session->impl()),
+                                   test::user::TABLE_NAME, {"first_name", "last_name", "dval", "tval"},
+                                   postgres::bulk_loader::BINARY, 128);
+
+      for (int i = 0; i < 100; i++) {
+        loader.add_row("Bryan", "Jenkins", 2.5, sql_time());
+      }
+
+      AssertThat(loader.finish(), Equals(100));
+
+      select_query query(test::current_session, {}, test::user::TABLE_NAME);
+
+      query.where(op::equals("dval", 2.5));
+
+      AssertThat(query.count(), Equals(100));
+    });
+
+    it("reports the failing row", []() {
+      postgres::bulk_loader loader(dynamic_pointer_cast<postgres::session>(test::current_session->impl()),
+                                   test::user::TABLE_NAME, {"first_name", "dval"});
+
+      loader.add_row("Bryan", 1);
+      loader.add_row("Mark", "abc");
+
+      try {
+        loader.finish();
+        AssertThat(true, IsFalse());
+      } catch (const database_exception &e) {
+        AssertThat(string(e.context()), Contains("line 2"));
+      }
+
+      AssertThat(loader.is_active(), IsFalse());
+    });
+
+    it("can be aborted", []() {
+      {
+        postgres::bulk_loader loader(dynamic_pointer_cast<postgres::session>(test::current_session->impl()),
+                                     test::user::TABLE_NAME, {"first_name"});
+
+        loader.add_row("Bryan");
+
+        loader.abort();
+
+        AssertThat(loader.is_active(), IsFalse());
+      }
+
+      select_query query(test::current_session, {}, test::user::TABLE_NAME);
+
+      AssertThat(query.count(), Equals(0));
+    });
+  });
+}
+SPEC_END;
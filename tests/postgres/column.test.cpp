@@ -3,6 +3,7 @@
 #include "../db.test.h"
 
 #include "postgres/column.h"
+#include "postgres/session.h"
 #include <bandit/bandit.h>
 #include <libpq-fe.h>
 #include <memory>
@@ -70,6 +71,30 @@ SPEC_BEGIN(postgres_column) {
 
       Assert::That(col->name(), Equals("last_name"));
     });
+
+    it("can decode binary results", []() {
+      auto sess = dynamic_pointer_cast<postgres::session>(test::current_session->impl());
+
+      sess->set_binary_results(true);
+
+      select_query q(test::current_session, {"first_name", "dval", "tval", "123.450::numeric",
+                                             "'a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11'::uuid", "null::int"},
+                     "users");
+
+      auto rs = q.execute();
+
+      sess->set_binary_results(false);
+
+      auto row = rs.begin();
+
+      Assert::That(row->column(0).value(), Equals(sql_value("test")));
+
+      Assert::That(row->column(3).value().to_string(), Equals("123.450"));
+
+      Assert::That(row->column(4).value().to_string(), Equals("a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11"));
+
+      Assert::That(row->column(5).value() == sql_null, IsTrue());
+    });
   });
 }
 SPEC_END;
@@ -3,6 +3,7 @@
 #include "../db.test.h"
 #include "postgres/session.h"
 #include "postgres/statement.h"
+#include "select_query.h"
 #include <bandit/bandit.h>
 
 using namespace bandit;
@@ -68,6 +69,33 @@ SPEC_BEGIN(postgres_statement) {
 
       AssertThat(stmt.is_valid(), IsTrue());
     });
+
+    it("prepares on the server", []() {
+      auto count_prepared = []() {
+        select_query query(test::current_session, {}, "pg_prepared_statements");
+        return query.count();
+      };
+
+      auto before = count_prepared();
+
+      {
+        postgres::statement stmt(dynamic_pointer_cast<postgres::session>(test::current_session->impl()));
+
+        stmt.prepare("select * from users where id = $1");
+
+        for (int i = 1; i <= 3; i++) {
+          stmt.bind(1, i);
+          stmt.query();
+          stmt.reset();
+        }
+
+        AssertThat(count_prepared(), Equals(before + 1));
+
+        stmt.finish();
+
+        AssertThat(count_prepared(), Equals(before));
+      }
+    });
   });
 }
 SPEC_END;
@@ -11,6 +11,22 @@ using namespace coda::db;
 
 using namespace snowhouse;
 
+namespace {
+  /*
+   * keeps a value from the row it was initialized with
+   */
+  class loaded_user : public test::user {
+   public:
+    std::string loaded_name;
+
+    explicit loaded_user(const std::shared_ptr<coda::db::schema> &schema) : user(schema) {}
+
+    void on_record_init(const row &values) override {
+      loaded_name = values.column("first_name").value().as<std::string>();
+    }
+  };
+}  // namespace
+
 specification(records, []() {
   describe("a user record", []() {
     before_each([]() { test::setup_current_session(); });
@@ -44,6 +60,93 @@ specification(records, []() {
       }
     });
 
+    it("tracks changed columns", []() {
+      test::user u1;
+
+      u1.set("first_name", "Clean");
+      u1.set("last_name", "Record");
+
+      Assert::That(u1.is_persisted(), IsFalse());
+
+      Assert::That(u1.is_dirty("first_name"), IsTrue());
+
+      Assert::That(u1.save(), IsTrue());
+
+      Assert::That(u1.is_persisted(), IsTrue());
+
+      Assert::That(u1.is_dirty(), IsFalse());
+
+      Assert::That(u1.save(), IsTrue());
+
+      auto u2 = test::user().find_by_id(u1.id());
+
+      Assert::That(u2 != nullptr, IsTrue());
+
+      Assert::That(u2->is_dirty(), IsFalse());
+
+      u2->set("last_name", "Changed");
+
+      Assert::That(u2->is_dirty("last_name"), IsTrue());
+
+      Assert::That(u2->is_dirty("first_name"), IsFalse());
+
+      Assert::That(u2->save(), IsTrue());
+
+      Assert::That(u1.refresh(), IsTrue());
+
+      Assert::That(u1.get("last_name"), Equals("Changed"));
+
+      Assert::That(u1.get("first_name"), Equals("Clean"));
+    });
+
+    it("saves again after being removed", []() {
+      test::user u1;
+
+      u1.set("first_name", "Removed");
+      u1.set("last_name", "Record");
+
+      Assert::That(u1.save(), IsTrue());
+
+      Assert::That(u1.remove(), IsTrue());
+
+      Assert::That(u1.is_persisted(), IsFalse());
+
+      Assert::That(u1.save(), IsTrue());
+
+      Assert::That(u1.is_persisted(), IsTrue());
+
+      auto u2 = test::user().find_by_id(u1.id());
+
+      Assert::That(u2 != nullptr, IsTrue());
+
+      Assert::That(u2->get("first_name"), Equals("Removed"));
+    });
+
+    it("can upsert", []() {
+      test::user u1;
+
+      u1.set("first_name", "Up");
+      u1.set("last_name", "Sert");
+
+      Assert::That(u1.upsert(), IsTrue());
+
+      test::user u2;
+
+      u2.set_id(u1.id());
+      u2.set("first_name", "Down");
+
+      Assert::That(u2.upsert(), IsTrue());
+
+      // an unchanged row is not a failure
+      Assert::That(u2.upsert(), IsTrue());
+
+      Assert::That(u1.refresh(), IsTrue());
+
+      Assert::That(u1.get("first_name"), Equals("Down"));
+
+      Assert::That(u1.get("last_name"), Equals("Sert"));
+    });
+
     it("should find by id", []() {
       test::user u1;
 
@@ -112,6 +215,128 @@ specification(records, []() {
       Assert::That(u2.get("last_name"), Equals("Robot"));
     });
 
+    it("can hold columns outside the schema", []() {
+      test::user user1;
+
+      user1.set("first_name", "Outside");
+      user1.set("nickname", "Out");
+
+      Assert::That(user1.has("nickname"), IsTrue());
+
+      Assert::That(user1.get("nickname"), Equals("Out"));
+
+      Assert::That(user1.save(), IsTrue());
+
+      user1.unset("first_name");
+
+      Assert::That(user1.has("first_name"), IsFalse());
+
+      Assert::That(user1.get("first_name") == nullptr, IsTrue());
+    });
+
+    describe("with the record cache", []() {
+      auto &cache = record_cache::global();
+
+      size_t capacity = 0;
+
+      before_each([&]() {
+        capacity = cache.capacity();
+
+        cache.set_capacity(10);
+      });
+
+      after_each([&]() {
+        cache.clear();
+
+        cache.set_capacity(capacity);
+      });
+
+      it("can be cached by id", [&]() {
+        test::user u1;
+
+        u1.set("first_name", "Cached");
+        u1.set("last_name", "Record");
+
+        Assert::That(u1.save(), IsTrue());
+
+        auto found = test::user().find_by_id(u1.id());
+
+        Assert::That(cache.size(), Equals(1));
+
+        auto hits = cache.hits();
+
+        auto again = test::user().find_by_id(u1.id());
+
+        Assert::That(cache.hits() - hits, Equals(1ULL));
+
+        Assert::That(again.get() != found.get(), IsTrue());
+
+        Assert::That(again->get("first_name"), Equals("Cached"));
+
+        again->set("first_name", "Changed");
+
+        Assert::That(again->save(), IsTrue());
+
+        Assert::That(cache.size(), Equals(0));
+
+        Assert::That(test::user().find_by_id(u1.id())->get("first_name"), Equals("Changed"));
+
+        Assert::That(u1.remove(), IsTrue());
+
+        Assert::That(test::user().find_by_id(u1.id()) == nullptr, IsTrue());
+      });
+
+      it("initializes cached records like loaded records", [&]() {
+        test::user u1;
+
+        u1.set("first_name", "Cached");
+
+        Assert::That(u1.save(), IsTrue());
+
+        auto schema = test::current_session->get_schema(test::user::TABLE_NAME);
+
+        auto loaded = find_by_id<loaded_user>(schema, u1.id());
+
+        auto hits = cache.hits();
+
+        auto cached = find_by_id<loaded_user>(schema, u1.id());
+
+        Assert::That(cache.hits() - hits, Equals(1ULL));
+
+        Assert::That(loaded->loaded_name, Equals("Cached"));
+
+        Assert::That(cached->loaded_name, Equals("Cached"));
+      });
+
+      it("does not keep values that are rolled back", [&]() {
+        test::user u1;
+
+        u1.set("first_name", "Committed");
+
+        Assert::That(u1.save(), IsTrue());
+
+        {
+          auto tx = test::current_session->start_transaction();
+
+          auto found = test::user().find_by_id(u1.id());
+
+          found->set("first_name", "Uncommitted");
+
+          Assert::That(found->save(), IsTrue());
+
+          Assert::That(test::user().find_by_id(u1.id())->get("first_name"), Equals("Uncommitted"));
+
+          Assert::That(cache.size(), Equals(0));
+
+          tx.rollback();
+        }
+
+        Assert::That(test::user().find_by_id(u1.id())->get("first_name"), Equals("Committed"));
+
+        Assert::That(test::user().find_by_id(u1.id())->get("first_name"), Equals("Committed"));
+      });
+    });
+
     it("can have no column", []() {
       test::user user1;
 
@@ -161,5 +161,168 @@ specification(resultsets, []() {
 
       Assert::That(j >= i, Equals(true));
     });
+
+    it("can view rows without copying", []() {
+      select_query select(test::current_session, {"id", "first_name", "last_name"}, test::user::TABLE_NAME);
+
+      select.order_by("id");
+
+      auto rs = select.execute();
+
+      vector<string> names;
+
+      rs.each_view([&names](const row_view &row) {
+        Assert::That(row.size(), Equals(3));
+
+        Assert::That(row.get<long long>(0) > 0, IsTrue());
+
+        Assert::That(row["last_name"].name(), Equals("last_name"));
+
+        names.push_back(row.get<string>(1));
+      });
+
+      Assert::That(names.size(), Equals(2));
+
+      Assert::That(names[0], Equals("Bryan"));
+
+      Assert::That(names[1], Equals("Mark"));
+
+      rs.reset();
+
+      Assert::That(rs.next(), IsTrue());
+
+      Assert::That(rs.get<string>(2), Equals("Jenkins"));
+
+      auto copy = rs.view().to_row();
+
+      Assert::That(rs.next(), IsTrue());
+
+      Assert::That(rs.view().column(2).as<string>(), Equals("Smith"));
+
+      Assert::That(copy.column(0).value().is<sql_number>(), IsTrue());
+
+      // the kept row still has the values from before next()
+      Assert::That(copy.column(2).value().as<string>(), Equals("Jenkins"));
+
+      Assert::That(copy.column("first_name").value().as<string>(), Equals("Bryan"));
+    });
+
+    it("continues iterating until reset", []() {
+      select_query select(test::current_session, {"first_name"}, test::user::TABLE_NAME);
+
+      select.order_by("id");
+
+      auto rs = select.execute();
+
+      Assert::That(rs.empty(), IsFalse());
+
+      vector<string> names;
+
+      for (auto &row : rs) {
+        names.push_back(row.column(0).value().as<string>());
+      }
+
+      Assert::That(names.size(), Equals(2));
+
+      Assert::That(rs.begin() == rs.end(), IsTrue());
+
+      rs.reset();
+
+      Assert::That(rs.begin()->column(0).value().as<string>(), Equals("Bryan"));
+
+      Assert::That(rs.size(), Equals(2));
+    });
+
+    it("can read typed tuples", []() {
+      select_query select(test::current_session, {"id", "first_name", "last_name"}, test::user::TABLE_NAME);
+
+      select.order_by("id");
+
+      vector<string> names;
+
+      for (auto [id, first, last] : select.execute().as<long long, string, std::optional<string>>()) {
+        Assert::That(id > 0, IsTrue());
+
+        Assert::That(last.has_value(), IsTrue());
+
+        names.push_back(first + " " + *last);
+      }
+
+      Assert::That(names.size(), Equals(2));
+
+      Assert::That(names[0], Equals("Bryan Jenkins"));
+
+      Assert::That(names[1], Equals("Mark Smith"));
+
+      AssertThrows(no_such_column_exception, select.execute().as<int, int, int, int>().begin());
+    });
+
+    it("can fetch batches of columns", []() {
+      select_query select(test::current_session, {"id", "first_name", "last_name"}, test::user::TABLE_NAME);
+
+      select.order_by("id");
+
+      auto rs = select.execute();
+
+      auto batch = rs.fetch_batch(1);
+
+      Assert::That(batch.size(), Equals(1));
+
+      Assert::That(batch.column_count(), Equals(3));
+
+      Assert::That(batch[0].kind(), Equals(batch_column::integer));
+
+      Assert::That(batch["first_name"].data(0), Equals("Bryan"));
+
+      Assert::That(rs.fetch_batch(batch, 10), Equals(1));
+
+      Assert::That(batch["last_name"].data(0), Equals("Smith"));
+
+      Assert::That(batch[2].is_null(0), IsFalse());
+
+      Assert::That(rs.fetch_batch(batch, 10), Equals(0));
+
+      Assert::That(batch.empty(), IsTrue());
+    });
+
+    it("can view text without copying", []() {
+      select_query select(test::current_session, {"first_name", "last_name"}, test::user::TABLE_NAME);
+
+      select.order_by("id");
+
+      auto rs = select.execute();
+
+      Assert::That(rs.next(), IsTrue());
+
+      Assert::That(rs.view()["first_name"].as_view() == "Bryan", IsTrue());
+
+      Assert::That(rs.current_row().column("last_name").as_view() == "Jenkins", IsTrue());
+    });
+
+    it("can find columns by name", []() {
+      select_query select(test::current_session, {"id", "first_name", "last_name"}, test::user::TABLE_NAME);
+
+      select.order_by("id");
+
+      auto rs = select.execute();
+
+      Assert::That(rs.next(), IsTrue());
+
+      Assert::That(rs.view()["first_name"].index(), Equals(1));
+
+      Assert::That(rs.begin()->column("last_name").value().as<string>(), Equals("Jenkins"));
+
+      AssertThrows(no_such_column_exception, rs.view()["FIRST_NAME"]);
+
+      rs.set_ignore_case(true);
+
+      rs.reset();
+
+      Assert::That(rs.next(), IsTrue());
+
+      Assert::That(rs.view()["FIRST_NAME"].as<string>(), Equals("Bryan"));
+
+      Assert::That(rs.begin()->column("Last_Name").value().as<string>(), Equals("Jenkins"));
+    });
   });
 });
@@ -0,0 +1,174 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "db.test.h"
+#include "exception.h"
+#include "session_pool.h"
+#include <bandit/bandit.h>
+
+using namespace bandit;
+
+using namespace std;
+
+using namespace coda::db;
+
+using namespace snowhouse;
+
+specification(session_pools, []() {
+  describe("session pool", []() {
+    before_each([]() { test::setup_current_session(); });
+
+    after_each([]() { test::teardown_current_session(); });
+
+    it("requires a valid size", []() {
+      session_pool::options opts;
+      opts.max_size = 0;
+
+      AssertThrows(database_exception, session_pool(test::current_session->connection_info(), opts));
+
+      opts.max_size = 1;
+      opts.min_size = 2;
+
+      AssertThrows(database_exception, session_pool(test::current_session->connection_info(), opts));
+    });
+
+    it("can fill to the minimum size", []() {
+      session_pool::options opts;
+      opts.min_size = 2;
+      opts.max_size = 4;
+
+      auto pool = make_shared<session_pool>(test::current_session->connection_info(), opts);
+
+      pool->fill();
+
+      Assert::That(pool->size(), Equals(2));
+
+      Assert::That(pool->idle_size(), Equals(2));
+    });
+
+    it("can acquire and release", []() {
+      auto pool = make_shared<session_pool>(test::current_session->connection_info());
+
+      {
+        auto handle = pool->acquire();
+
+        Assert::That(handle->is_open(), IsTrue());
+
+        Assert::That(pool->in_use(), Equals(1));
+      }
+
+      Assert::That(pool->in_use(), Equals(0));
+
+      Assert::That(pool->idle_size(), Equals(1));
+
+      auto first = pool->acquire().get();
+
+      Assert::That(pool->acquire().get() == first, IsTrue());
+    });
+
+    it("times out when exhausted", []() {
+      session_pool::options opts;
+      opts.max_size = 1;
+
+      auto pool = make_shared<session_pool>(test::current_session->connection_info(), opts);
+
+      auto handle = pool->acquire();
+
+      AssertThrows(database_exception, pool->acquire(std::chrono::milliseconds(10)));
+
+      handle.release();
+
+      Assert::That(pool->acquire(std::chrono::milliseconds(10)), IsTrue());
+    });
+
+    it("hands a released session to a waiter", []() {
+      session_pool::options opts;
+      opts.max_size = 1;
+
+      auto pool = make_shared<session_pool>(test::current_session->connection_info(), opts);
+
+      auto handle = pool->acquire();
+
+      bool acquired = false;
+
+      std::thread waiter([&]() { acquired = static_cast<bool>(pool->acquire(std::chrono::seconds(5))); });
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+      handle.release();
+
+      waiter.join();
+
+      Assert::That(acquired, IsTrue());
+
+      Assert::That(pool->size(), Equals(1));
+    });
+
+    it("discards invalid sessions", []() {
+      session_pool::options opts;
+      opts.validator = [](const std::shared_ptr<session> &) { return false; };
+
+      auto pool = make_shared<session_pool>(test::current_session->connection_info(), opts);
+
+      auto handle = pool->acquire();
+
+      handle.invalidate();
+
+      handle.release();
+
+      Assert::That(pool->size(), Equals(0));
+
+      auto other = pool->acquire();
+
+      other->close();
+
+      other.release();
+
+      Assert::That(pool->size(), Equals(0));
+    });
+
+    it("evicts idle sessions", []() {
+      session_pool::options opts;
+      opts.min_size = 1;
+      opts.idle_timeout = std::chrono::milliseconds(1);
+
+      auto pool = make_shared<session_pool>(test::current_session->connection_info(), opts);
+
+      {
+        auto a = pool->acquire();
+        auto b = pool->acquire();
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+      pool->evict_idle();
+
+      Assert::That(pool->size(), Equals(1));
+    });
+
+    it("is thread safe", []() {
+      session_pool::options opts;
+      opts.max_size = 2;
+
+      auto pool = make_shared<session_pool>(test::current_session->connection_info(), opts);
+
+      std::vector<std::thread> workers;
+
+      for (int i = 0; i < 4; i++) {
+        workers.emplace_back([&pool]() {
+          for (int j = 0; j < 20; j++) {
+            auto handle = pool->acquire();
+            handle->is_open();
+          }
+        });
+      }
+
+      for (auto &worker : workers) {
+        worker.join();
+      }
+
+      Assert::That(pool->size() <= 2, IsTrue());
+    });
+  });
+});
@@ -16,5 +16,8 @@ SPEC_REG(rows);
 SPEC_REG(schemas);
 SPEC_REG(schema_factories);
 SPEC_REG(selects);
+SPEC_REG(session_pools);
+SPEC_REG(statement_caches);
 SPEC_REG(transactions);
+SPEC_REG(units_of_work);
 SPEC_REG(updates);
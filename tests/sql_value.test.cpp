@@ -1,7 +1,9 @@
 #include <string>
 
 #include "exception.h"
+#include "number_format.h"
 #include "sql_value.h"
+#include "unicode.h"
 #include <bandit/bandit.h>
 
 using namespace bandit;
@@ -64,6 +66,68 @@ go_bandit([]() {
       Assert::That(timestamp.to_string(), Equals("2016-03-11 08:15:30"));
     });
 
+    it("has sub-second precision", []() {
+      sql_time value;
+
+      AssertThat(value.parse("2016-03-11T10:15:30.123456+02:00"), IsTrue());
+
+      AssertThat(value.format(), Equals(sql_time::DATETIME));
+
+      AssertThat(value.microseconds(), Equals(123456));
+
+      AssertThat(value.to_string(), Equals("2016-03-11 08:15:30.123456"));
+
+      AssertThat(sql_value(value).as<sql_time>(), Equals(value));
+
+      AssertThat(value.parse("2016-02-30"), IsFalse());
+
+      AssertThat(value.microseconds(), Equals(123456));
+
+      sql_time before(std::string("1969-12-31 23:59:59.5"));
+
+      AssertThat(before.value(), Equals(-1));
+
+      AssertThat(before.to_string(), Equals("1969-12-31 23:59:59.5"));
+    });
+
+    it("formats elapsed times", []() {
+      using std::chrono::hours;
+
+      sql_time negative(sql_time::time_point(hours(-1)), sql_time::TIME);
+
+      AssertThat(negative.to_string(), Equals("-01:00:00"));
+
+      sql_time over(sql_time::time_point(hours(100)), sql_time::TIME);
+
+      AssertThat(over.to_string(), Equals("100:00:00"));
+
+      sql_time value;
+
+      AssertThat(value.parse(negative.to_string()), IsTrue());
+
+      AssertThat(value.format(), Equals(sql_time::TIME));
+
+      AssertThat(value.to_time_point() == negative.to_time_point(), IsTrue());
+
+      AssertThat(value.parse(over.to_string()), IsTrue());
+
+      AssertThat(value.to_time_point() == over.to_time_point(), IsTrue());
+
+      AssertThat(value.parse("838:59:59"), IsTrue());
+
+      AssertThat(value.parse("839:00:00"), IsFalse());
+
+      AssertThat(value.parse("2020-01-01 24:00:00"), IsFalse());
+
+      AssertThat(value.parse("2020-01-01 23:59:60"), IsFalse());
+
+      AssertThat(value.parse("23:59:60"), IsFalse());
+
+      AssertThat(value.parse("23:59:59"), IsTrue());
+
+      AssertThat(value.to_string(), Equals("23:59:59"));
+    });
+
     it("can be outputed to a stream", [&tm]() {
       sql_time value(timegm(&tm));
 
@@ -101,6 +165,30 @@ go_bandit([]() {
       AssertThat(other == 1234, IsTrue());
     });
 
+    it("is compact", []() {
+      AssertThat(sizeof(sql_value), Equals(16U));
+
+      sql_value small = "abc";
+
+      AssertThat(small.as_view(), Equals("abc"));
+
+      std::string text(64, 'x');
+
+      sql_value large = text;
+
+      sql_value copy = large;
+
+      AssertThat(copy.as_view().data() == large.as_view().data(), IsTrue());
+
+      AssertThat(copy, Equals(text));
+
+      sql_value precise = 1.5L;
+
+      AssertThat(precise.as<long double>(), Equals(1.5L));
+
+      AssertThat(sql_value(sql_time(1000, sql_time::DATE)).as<sql_time>().format(), Equals(sql_time::DATE));
+    });
+
     describe("conversion", []() {
       describe("an integer", []() {
         sql_value v = 1234;
@@ -174,6 +262,18 @@ go_bandit([]() {
       // });
     });
 
+    it("converts wide strings as UTF-8", []() {
+      std::string text = u8"caf\u00e9 \u65e5\u672c \U0001F389";
+
+      sql_value value = text;
+
+      AssertThat(value.as<sql_wstring>(), Equals(std::wstring(L"caf\u00e9 \u65e5\u672c \U0001F389")));
+
+      AssertThat(sql_value(value.as<sql_wstring>()).as<sql_string>(), Equals(text));
+
+      AssertThat(helper::utf8_to_utf16("\xC0\xAFx"), Equals(std::u16string(u"\uFFFDx")));
+    });
+
     it("can be outputed to a stream", []() {
       sql_value value(12341234);
 
@@ -185,6 +285,36 @@ go_bandit([]() {
     });
   });
 
+  describe("sql number", []() {
+    it("round trips floating point text", []() {
+      sql_number value(0.1);
+
+      AssertThat(value.to_string(), Equals("0.1"));
+
+      AssertThat(sql_number(value.to_string()).as<double>(), Equals(0.1));
+
+      AssertThat(sql_number(sql_string("0.1")).as<double>(), Equals(0.1));
+
+      AssertThat(sql_number(sql_string("18446744073709551615")).as<unsigned long long>(), Equals(18446744073709551615ULL));
+    });
+
+    it("parses text without exceptions", []() {
+      long long value = 0;
+
+      AssertThat(helper::parse_number(" +42 ", value), IsTrue());
+
+      AssertThat(value, Equals(42));
+
+      AssertThat(helper::parse_number("42abc", value), IsFalse());
+
+      AssertThat(helper::parse_number("99999999999999999999", value), IsFalse());
+
+      AssertThat(value, Equals(42));
+
+      AssertThat(helper::format_number(-1.25), Equals("-1.25"));
+    });
+  });
+
   describe("sql null", []() {
     it("can be a string",
        []() { AssertThat(to_string(sql_null), Equals("NULL")); });
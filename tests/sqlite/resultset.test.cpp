@@ -96,6 +96,42 @@ SPEC_BEGIN(sqlite_resultset) {
 
       AssertThrows(database_exception, query.execute());
     });
+
+    it("can buffer results", []() {
+      auto sess = dynamic_pointer_cast<sqlite::session>(test::current_session->impl());
+
+      sess->set_buffered_results(true);
+
+      select_query query(test::current_session, {"first_name"}, "users");
+
+      query.order_by("id");
+
+      auto rs = query.execute();
+
+      sess->set_buffered_results(false);
+
+      Assert::That(rs.impl()->row_count(), Equals(2));
+
+      Assert::That(rs.size(), Equals(2));
+
+      Assert::That(rs.empty(), IsFalse());
+
+      Assert::That(rs.next(), IsTrue());
+
+      Assert::That(rs.get<string>(0), Equals("Bryan"));
+
+      Assert::That(rs.begin()->column("first_name").value().as<string>(), Equals("Bryan"));
+
+      Assert::That(rs.next(), IsTrue());
+
+      Assert::That(rs.next(), IsFalse());
+
+      rs.reset();
+
+      Assert::That(rs.next(), IsTrue());
+
+      Assert::That(rs.get<string>(0), Equals("Bryan"));
+    });
   });
 }
 SPEC_END;
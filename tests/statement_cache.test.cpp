@@ -0,0 +1,108 @@
+#include <string>
+
+#include "db.test.h"
+#include "insert_query.h"
+#include "select_query.h"
+#include "statement.h"
+#include <bandit/bandit.h>
+
+using namespace bandit;
+
+using namespace std;
+
+using namespace coda::db;
+
+using namespace snowhouse;
+
+specification(statement_caches, []() {
+  describe("statement cache", []() {
+    before_each([]() {
+      test::setup_current_session();
+      test::current_session->statements().clear();
+    });
+
+    after_each([]() { test::teardown_current_session(); });
+
+    it("reuses statements for the same sql", []() {
+      auto &cache = test::current_session->statements();
+
+      auto hits = cache.hits();
+      auto misses = cache.misses();
+
+      for (int i = 0; i < 3; i++) {
+        insert_query insert(test::current_session, test::user::TABLE_NAME, {"first_name", "last_name"});
+
+        insert.values("Bryan", "Jenkins");
+
+        Assert::That(insert.execute(), Equals(1));
+      }
+
+      Assert::That(cache.misses() - misses, Equals(1));
+
+      Assert::That(cache.hits() - hits, Equals(2));
+
+      Assert::That(cache.size(), Equals(1));
+    });
+
+    it("does not share a statement with unread results", []() {
+      test::user user;
+      user.set("first_name", "Mark");
+      user.set("last_name", "Smith");
+      user.save();
+
+      select_query outer(test::current_session, {}, test::user::TABLE_NAME);
+
+      auto results = outer.execute();
+
+      select_query inner(test::current_session, {}, test::user::TABLE_NAME);
+
+      Assert::That(inner.execute().size(), Equals(results.size()));
+
+      Assert::That(results.is_valid(), IsTrue());
+    });
+
+    it("does not keep statements from a closed connection", []() {
+      auto &cache = test::current_session->statements();
+
+      auto stmt = test::current_session->prepare_statement("select * from users");
+
+      test::current_session->close();
+
+      test::current_session->open();
+
+      stmt = nullptr;
+
+      Assert::That(cache.size(), Equals(0));
+
+      auto misses = cache.misses();
+
+      select_query query(test::current_session, {}, test::user::TABLE_NAME);
+
+      Assert::That(query.execute().size(), Equals(0));
+
+      Assert::That(cache.misses() - misses, Equals(1));
+    });
+
+    it("can be limited", []() {
+      auto &cache = test::current_session->statements();
+
+      auto stmt = test::current_session->prepare_statement("select * from users");
+
+      stmt = nullptr;
+
+      Assert::That(cache.size(), Equals(1));
+
+      cache.set_capacity(0);
+
+      Assert::That(cache.size(), Equals(0));
+
+      stmt = test::current_session->prepare_statement("select * from users");
+
+      stmt = nullptr;
+
+      Assert::That(cache.size(), Equals(0));
+
+      cache.set_capacity(statement_cache::DEFAULT_CAPACITY);
+    });
+  });
+});
@@ -0,0 +1,168 @@
+#include <string>
+
+#include "db.test.h"
+#include "select_query.h"
+#include "unit_of_work.h"
+#include <bandit/bandit.h>
+
+using namespace bandit;
+
+using namespace std;
+
+using namespace coda::db;
+
+using namespace snowhouse;
+
+specification(units_of_work, []() {
+  describe("a unit of work", []() {
+    before_each([]() { test::setup_current_session(); });
+
+    after_each([]() { test::teardown_current_session(); });
+
+    it("can flush new, changed and removed records", []() {
+      unit_of_work work(test::current_session);
+
+      std::vector<std::shared_ptr<test::user>> users;
+
+      for (int i = 0; i < 10; i++) {
+        auto user = std::make_shared<test::user>();
+
+        user->set("first_name", "first" + std::to_string(i));
+        user->set("last_name", "last" + std::to_string(i));
+
+        work.save(user);
+
+        users.push_back(user);
+      }
+
+      Assert::That(work.size(), Equals(10));
+
+      Assert::That(work.flush(), Equals(10));
+
+      Assert::That(work.size(), Equals(0));
+
+      for (auto &user : users) {
+        Assert::That(user->is_persisted(), IsTrue());
+
+        Assert::That(user->is_dirty(), IsFalse());
+      }
+
+      users[0]->set("first_name", "changed");
+
+      work.save(users[0]).remove(users[1]).remove(users[2]);
+
+      Assert::That(work.flush(), Equals(3));
+
+      Assert::That(users[1]->is_persisted(), IsFalse());
+
+      auto found = test::user().find_by_id(users[0]->id());
+
+      Assert::That(found->get("first_name"), Equals("changed"));
+
+      select_query query(test::current_session);
+
+      Assert::That(query.from(test::user::TABLE_NAME).count(), Equals(8));
+    });
+
+    it("leaves records unchanged when a flush fails", []() {
+      unit_of_work work(test::current_session);
+
+      auto user = std::make_shared<test::user>();
+
+      user->set("first_name", "Never");
+      user->set("last_name", "Saved");
+
+      work.save(user);
+
+      auto settings = test::current_session->get_schema("user_settings");
+
+      auto valid = std::make_shared<generic::record>(settings);
+
+      valid->set("user_id", 1);
+      valid->set("valid", 1);
+
+      // user_id is not null
+      auto invalid = std::make_shared<generic::record>(settings);
+
+      invalid->set("valid", 0);
+
+      work.save(valid).save(invalid);
+
+      AssertThrows(database_exception, work.flush());
+
+      select_query users(test::current_session);
+
+      Assert::That(users.from(test::user::TABLE_NAME).count(), Equals(0));
+
+      select_query rows(test::current_session);
+
+      Assert::That(rows.from("user_settings").count(), Equals(0));
+
+      std::vector<unit_of_work::record_type> records = {user, valid, invalid};
+
+      for (auto &record : records) {
+        Assert::That(record->is_persisted(), IsFalse());
+
+        Assert::That(record->is_dirty(), IsTrue());
+
+        Assert::That(record->has("id"), IsFalse());
+      }
+
+      Assert::That(work.size(), Equals(3));
+    });
+
+    it("joins a transaction the caller started", []() {
+      auto tx = test::current_session->start_transaction();
+
+      unit_of_work work(test::current_session);
+
+      auto user = std::make_shared<test::user>();
+
+      user->set("first_name", "Inside");
+      user->set("last_name", "Transaction");
+
+      Assert::That(work.save(user).flush(), Equals(1));
+
+      // user_id is not null
+      auto invalid = std::make_shared<generic::record>(test::current_session->get_schema("user_settings"));
+
+      invalid->set("valid", 0);
+
+      AssertThrows(database_exception, work.save(invalid).flush());
+
+      // only the failed flush is undone
+      Assert::That(test::current_session->in_transaction(), IsTrue());
+
+      select_query users(test::current_session);
+
+      Assert::That(users.from(test::user::TABLE_NAME).count(), Equals(1));
+
+      tx.rollback();
+
+      select_query rolled_back(test::current_session);
+
+      Assert::That(rolled_back.from(test::user::TABLE_NAME).count(), Equals(0));
+    });
+
+    it("keeps one instance of each record", []() {
+      test::user user;
+
+      user.set("first_name", "Only");
+      user.set("last_name", "One");
+
+      Assert::That(user.save(), IsTrue());
+
+      unit_of_work work(test::current_session);
+
+      auto schema = test::current_session->get_schema(test::user::TABLE_NAME);
+
+      auto found = work.find_by_id<test::user>(schema, user.id());
+
+      Assert::That(found != nullptr, IsTrue());
+
+      Assert::That(work.find_by_id<test::user>(schema, user.id()).get() == found.get(), IsTrue());
+
+      Assert::That(work.identities().size(), Equals(1));
+    });
+  });
+});